@@ -0,0 +1,77 @@
+#ifndef ALGORITHMS_CLUSTERNCC
+#define ALGORITHMS_CLUSTERNCC
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "Algorithms/DetectionStrategies/NegativeCycleDetection.h"
+#include "Algorithms/ResidualCosts/StandardResidualCostComputer.h"
+#include "Algorithms/NegativeCycleCanceling.h"
+
+#include "Auxiliary/Constants.h"
+#include "Auxiliary/ReturnCodes.h"
+
+#include "DataStructures/Graphs/WindfarmResidual.h"
+#include "DataStructures/Instance.h"
+
+#include "IO/NCCLogger.h"
+
+namespace wcp {
+
+namespace Algorithms {
+
+/**
+ * Negative cycle canceling restricted to the subgraph induced by one cluster
+ * of vertices, e.g., the turbines served by one substation. The flow in
+ * windfarm must be feasible; only edges within the cluster are changed.
+ *
+ * Used by NegativeCycleCanceling::RunDecomposedNCC on a copy of the windfarm per cluster.
+ */
+class ClusterNCC : public NegativeCycleCanceling {
+public:
+    ClusterNCC( DataStructures::Instance& instance,
+                WindfarmResidual& windfarm,
+                IO::NCCLogger& logger,
+                std::unique_ptr<Algorithms::NegativeCycleDetection>&& detectionStrategy,
+                std::vector<vertexID> cluster,
+                double maxRunningTimeInMilliseconds = Auxiliary::DINFTY)
+      : NegativeCycleCanceling( instance,
+                                windfarm,
+                                logger,
+                                nullptr,
+                                nullptr,
+                                std::move(detectionStrategy),
+                                0,
+                                false,
+                                std::cout,
+                                maxRunningTimeInMilliseconds),
+        residualCostComputer_(windfarm),
+        cluster_(std::move(cluster)) {}
+
+    /**
+     * Cancels negative cycles within the cluster for all deltas until none is left.
+     */
+    ReturnCode Run() {
+        solutionCosts_ = windfarm_.ComputeTotalCostOfFlow();
+        ReturnCode valueForReturn;
+        do {
+            valueForReturn = RunNCCforAllDeltasOnWindow(cluster_);
+        } while (valueForReturn == ReturnCode::SUCCESS);
+        return valueForReturn;
+    }
+
+    const std::vector<vertexID>& Cluster() const { return cluster_; }
+
+private:
+    StandardResidualCostComputer& ResidualCostComputer() { return residualCostComputer_; }
+
+    StandardResidualCostComputer residualCostComputer_;
+    std::vector<vertexID> cluster_;
+};
+
+} // namespace Algorithms
+
+} // namespace wcp
+
+#endif
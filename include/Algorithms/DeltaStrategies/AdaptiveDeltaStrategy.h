@@ -0,0 +1,142 @@
+#ifndef ALGORITHMS_DELTASTRATEGIES_ADAPTIVEDELTASTRATEGY
+#define ALGORITHMS_DELTASTRATEGIES_ADAPTIVEDELTASTRATEGY
+
+#include "Algorithms/DeltaStrategies/DeltaStrategy.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <iomanip>
+#include <limits>
+#include <vector>
+
+#include "Auxiliary/Constants.h"
+
+namespace wcp {
+
+namespace Algorithms {
+
+/**
+ * A delta strategy that learns which deltas pay off on the current instance.
+ *
+ * For each delta, it records the total decrease in cost and the total time spent
+ * in detection runs. Unsuccessful runs contribute no decrease, so the resulting
+ * cost decrease per millisecond also reflects the success rate. The next delta is
+ * picked by the UCB1 rule from the deltas that have not been tried since the last
+ * time a negative cycle was canceled. Hence, as with the other strategies, NCC only
+ * stops after all deltas have been tried without success.
+ */
+class AdaptiveDeltaStrategy : public DeltaStrategy {
+public:
+    AdaptiveDeltaStrategy(int maximumFlowChange)
+      : DeltaStrategy(maximumFlowChange),
+        numberOfRuns_(maximumFlowChange + 1, 0),
+        totalCostDecrease_(maximumFlowChange + 1, 0.0),
+        totalMilliseconds_(maximumFlowChange + 1, 0.0),
+        triedSinceLastCancellation_(maximumFlowChange + 1, false),
+        totalNumberOfRuns_(0)
+    {}
+
+    int FirstDelta() {
+        ResetTriedDeltas();
+        return PickDelta();
+    }
+
+    int NextDelta(int /* currentDelta */, bool canceledNegativeCycle) {
+        if (canceledNegativeCycle) {
+            ResetTriedDeltas();
+        }
+        return PickDelta();
+    }
+
+    bool Continue(int upcomingDelta) {
+        return upcomingDelta > 0 && upcomingDelta <= MaximumFlowChange();
+    }
+
+    void ReportDetectionRun(int currentDelta, double costDecrease, double elapsedMilliseconds) {
+        assert(currentDelta > 0 && currentDelta <= MaximumFlowChange());
+        ++numberOfRuns_[currentDelta];
+        ++totalNumberOfRuns_;
+        totalCostDecrease_[currentDelta] += std::max(costDecrease, 0.0);
+        totalMilliseconds_[currentDelta] += std::max(elapsedMilliseconds, 0.0);
+    }
+
+    /**
+     * The statistics carry over from one NCC run to the next; the tried deltas are reset in FirstDelta.
+     */
+    void WriteState(std::ostream& os) const {
+        os << std::setprecision(std::numeric_limits<double>::max_digits10) << totalNumberOfRuns_;
+        for (int delta = 1; delta < static_cast<int>(numberOfRuns_.size()); ++delta) {
+            os << ' ' << numberOfRuns_[delta] << ' ' << totalCostDecrease_[delta] << ' ' << totalMilliseconds_[delta];
+        }
+    }
+
+    void ReadState(std::istream& is) {
+        is >> totalNumberOfRuns_;
+        for (int delta = 1; delta < static_cast<int>(numberOfRuns_.size()); ++delta) {
+            is >> numberOfRuns_[delta] >> totalCostDecrease_[delta] >> totalMilliseconds_[delta];
+        }
+    }
+
+private:
+    std::vector<unsigned int> numberOfRuns_;
+    std::vector<double> totalCostDecrease_;
+    std::vector<double> totalMilliseconds_;
+    std::vector<bool> triedSinceLastCancellation_;
+    unsigned int totalNumberOfRuns_;
+
+    /**
+     * Returns the untried delta with the highest upper confidence bound, or -1 if all deltas have been tried.
+     * Deltas without any run so far are picked first, in increasing order.
+     */
+    int PickDelta() {
+        // UCB1 expects rewards in [0,1], so we normalize by the best observed rate
+        double bestRate = 0;
+        for (int delta = 1; delta <= MaximumFlowChange(); ++delta) {
+            if (numberOfRuns_[delta] > 0) {
+                bestRate = std::max(bestRate, CostDecreasePerMillisecond(delta));
+            }
+        }
+
+        int bestDelta = -1;
+        double bestScore = -1;
+        for (int delta = 1; delta <= MaximumFlowChange(); ++delta) {
+            if (triedSinceLastCancellation_[delta]) { continue; }
+
+            double score;
+            if (numberOfRuns_[delta] == 0) {
+                score = Auxiliary::DINFTY;
+            } else {
+                double normalizedReward = (bestRate > 0) ? CostDecreasePerMillisecond(delta) / bestRate : 0;
+                score = normalizedReward + std::sqrt(2.0 * std::log(static_cast<double>(totalNumberOfRuns_)) / numberOfRuns_[delta]);
+            }
+
+            if (score > bestScore) {
+                bestScore = score;
+                bestDelta = delta;
+            }
+        }
+
+        if (bestDelta > 0) {
+            triedSinceLastCancellation_[bestDelta] = true;
+        }
+        return bestDelta;
+    }
+
+    double CostDecreasePerMillisecond(int delta) {
+        // Very fast runs are capped so that a single lucky run does not dominate
+        return totalCostDecrease_[delta] / std::max(totalMilliseconds_[delta], MINIMUM_MILLISECONDS_PER_RUN * numberOfRuns_[delta]);
+    }
+
+    void ResetTriedDeltas() {
+        std::fill(triedSinceLastCancellation_.begin(), triedSinceLastCancellation_.end(), false);
+    }
+
+    static constexpr double MINIMUM_MILLISECONDS_PER_RUN = 0.001;
+};
+
+} // namespace Algorithms
+
+} // namespace wcp
+
+#endif
@@ -0,0 +1,78 @@
+#ifndef ALGORITHMS_DELTASTRATEGIES_CANDIDATEDELTAFILTER
+#define ALGORITHMS_DELTASTRATEGIES_CANDIDATEDELTAFILTER
+
+#include <cassert>
+#include <vector>
+
+#include "DataStructures/Cabletypes.h"
+#include "DataStructures/Graphs/WindfarmResidual.h"
+
+namespace wcp {
+
+namespace Algorithms {
+
+/**
+ * Decides before a detection run whether a delta can yield a negative cycle at all.
+ *
+ * A negative cycle contains an edge with negative residual cost. With standard
+ * residual costs, whether an edge with flow f has negative residual cost for delta d
+ * only depends on f and d: the flow f + d must be feasible and cheaper than f.
+ * Since the cost function is a step function, this only holds if f + d falls
+ * below a capacity breakpoint that f is above. We tabulate this once and check
+ * the flow values that currently occur via the flow histogram of the windfarm.
+ */
+class CandidateDeltaFilter {
+public:
+    CandidateDeltaFilter(const DataStructures::Cabletypes& cabletypes, int maximumFlowChange)
+      : maximumCapacity_(cabletypes.MaximumCapacity()),
+        maximumFlowChange_(maximumFlowChange),
+        isCheaperAfterChange_((2 * maximumCapacity_ + 1) * (maximumFlowChange_ + 1), false)
+    {
+        for (int flow = -maximumCapacity_; flow <= maximumCapacity_; ++flow) {
+            for (int delta = 1; delta <= maximumFlowChange_; ++delta) {
+                if (flow + delta <= maximumCapacity_
+                        && cabletypes.CostOfFlow(flow + delta) < cabletypes.CostOfFlow(flow)) {
+                    isCheaperAfterChange_[Index(flow, delta)] = true;
+                }
+            }
+        }
+    }
+
+    /**
+     * Returns false only if no edge can have negative standard residual costs for delta.
+     * Each original edge with flow f yields residual edges with flow f and -f.
+     */
+    bool CanYieldNegativeCycle(int delta, const DataStructures::WindfarmResidual& windfarm) const {
+        if (delta < 1 || delta > maximumFlowChange_) { return true; }
+        if (windfarm.NumberOfEdgesOutsideFlowHistogram() > 0) { return true; }
+
+        const std::vector<int>& flowHistogram = windfarm.FlowHistogram();
+        assert(flowHistogram.size() == static_cast<size_t>(2 * maximumCapacity_ + 1));
+        for (int flow = -maximumCapacity_; flow <= maximumCapacity_; ++flow) {
+            if (flowHistogram[flow + maximumCapacity_] == 0) { continue; }
+            if (isCheaperAfterChange_[Index(flow, delta)] || isCheaperAfterChange_[Index(-flow, delta)]) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+private:
+    size_t Index(int flow, int delta) const {
+        return static_cast<size_t>(flow + maximumCapacity_) * (maximumFlowChange_ + 1) + delta;
+    }
+
+    int maximumCapacity_;
+    int maximumFlowChange_;
+
+    /**
+     * Entry (flow, delta) states whether changing flow to flow + delta is feasible and decreases the costs.
+     */
+    std::vector<bool> isCheaperAfterChange_;
+};
+
+} // namespace Algorithms
+
+} // namespace wcp
+
+#endif
@@ -1,6 +1,9 @@
 #ifndef ALGORITHMS_DELTASTRATEGIES_DELTASTRATEGY
 #define ALGORITHMS_DELTASTRATEGIES_DELTASTRATEGY
 
+#include <istream>
+#include <ostream>
+
 namespace wcp {
 
 namespace Algorithms {
@@ -31,6 +34,22 @@ public:
      */
     virtual bool Continue(int upcomingDelta) = 0;
 
+    /**
+     * Informs the strategy about the detection run with delta 'currentDelta' that
+     * has just finished. It decreased the cost of the flow by 'costDecrease' and
+     * took 'elapsedMilliseconds'. It is called before NextDelta. Strategies that
+     * do not learn from previous runs ignore this information.
+     */
+    virtual void ReportDetectionRun(int /*currentDelta*/, double /*costDecrease*/, double /*elapsedMilliseconds*/) {}
+
+    /**
+     * Writes and reads the state that carries over from one NCC run to the next,
+     * e.g., a random number generator, so that a run can be resumed from a
+     * checkpoint. Strategies that start over in every NCC run write nothing.
+     */
+    virtual void WriteState(std::ostream& /*os*/) const {}
+    virtual void ReadState(std::istream& /*is*/) {}
+
     /**
      * Returns the highest possible delta.
      */
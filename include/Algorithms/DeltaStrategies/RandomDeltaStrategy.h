@@ -56,6 +56,20 @@ struct RandomDeltaStrategy : DeltaStrategy {
         return Continue();
     }
 
+    void WriteState(std::ostream& os) const {
+        os << rng_ << ' ' << numberOfDeltasSinceUpdate_;
+        for (int delta : allDeltasRandomized_) {
+            os << ' ' << delta;
+        }
+    }
+
+    void ReadState(std::istream& is) {
+        is >> rng_ >> numberOfDeltasSinceUpdate_;
+        for (int& delta : allDeltasRandomized_) {
+            is >> delta;
+        }
+    }
+
 private:
     std::vector<int> allDeltasRandomized_;
     unsigned int numberOfDeltasSinceUpdate_;
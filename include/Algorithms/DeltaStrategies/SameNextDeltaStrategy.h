@@ -23,7 +23,8 @@ public:
     SameNextDeltaStrategy(std::unique_ptr<DeltaStrategy>&& deltaStrategy)
       : DeltaStrategy(deltaStrategy->MaximumFlowChange()),
         deltaStrategy_(std::move(deltaStrategy)),
-        lastCanceled_(false)
+        lastCanceled_(false),
+        lastCanceledDelta_(-1)
     {}
 
     int FirstDelta() {
@@ -53,6 +54,20 @@ public:
     bool Continue(int upcomingDelta) {
         return deltaStrategy_->Continue(upcomingDelta);
     }
+
+    void ReportDetectionRun(int currentDelta, double costDecrease, double elapsedMilliseconds) {
+        deltaStrategy_->ReportDetectionRun(currentDelta, costDecrease, elapsedMilliseconds);
+    }
+
+    void WriteState(std::ostream& os) const {
+        os << lastCanceled_ << ' ' << lastCanceledDelta_ << ' ';
+        deltaStrategy_->WriteState(os);
+    }
+
+    void ReadState(std::istream& is) {
+        is >> lastCanceled_ >> lastCanceledDelta_;
+        deltaStrategy_->ReadState(is);
+    }
 private:
     std::unique_ptr<DeltaStrategy>  deltaStrategy_;
     bool                            lastCanceled_; // equals canceledNegativeCycle from the last invocation of NextDelta
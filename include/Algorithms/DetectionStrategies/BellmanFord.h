@@ -3,9 +3,11 @@
 
 #include <algorithm>
 #include <iterator>
+#include <memory>
 #include <vector>
 
 #include "Algorithms/DetectionStrategies/NegativeCycleDetection.h"
+#include "Auxiliary/EpochMarks.h"
 #include "Auxiliary/ReturnCodes.h"
 #include "DataStructures/Graphs/WindfarmResidual.h"
 #include "DataStructures/Labels/OneDistanceLabel.h"
@@ -49,7 +51,8 @@ public:
         currentWalkIndex_(0),
         updatedSinceLastTime_(windfarm.NumberOfVertices(), true),
         vertexOfLastUpdate_(windfarm.NumberOfVertices() - 1),
-        earlyTermination_(false) {}
+        earlyTermination_(false),
+        isRestrictedToRegion_(false) {}
 
     /**
      * Runs the Bellman-Ford algorithm for the fixed number of rounds depending on the LabelType.
@@ -57,6 +60,7 @@ public:
      * updates and returns ReturnCode::SUCCESS, otherwise.
      */
     ReturnCode Run() {
+        isRestrictedToRegion_ = false;
         Reset();
         InitializeLabels();
 
@@ -71,8 +75,10 @@ public:
                     return ReturnCode::EARLY_TERMINATION;
                 }
 
+                if (IsCancelled()) { return AbortRun(); }
+
                 if (updatedSinceLastTime_[vertex]) {
-                    RelaxOutgoingEdges(vertex);
+                    RelaxOutgoingEdges<false>(vertex);
                     updatedSinceLastTime_[vertex] = false; // Will be set to true if an incoming edge allowed a relaxation, i.e. the label at vertex is changed
                 }
             }
@@ -80,34 +86,64 @@ public:
         return ReturnCode::SUCCESS;
     }
 
+    /**
+     * Runs the Bellman-Ford algorithm on the subgraph induced by regionVertices.
+     * The number of rounds depends on the size of the region, so the run is
+     * cheap for small regions. Labels outside the region are left untouched.
+     */
+    ReturnCode RunOnRegion(const std::vector<vertexID>& regionVertices) {
+        SetRegion(regionVertices);
+        ResetRegion();
+        InitializeLabelsInRegion();
+
+        if (regionVertices_.empty()) {
+            earlyTermination_ = true;
+            return ReturnCode::EARLY_TERMINATION;
+        }
+
+        for (int i = 0; i < NumberOfIterationsForVertices(regionVertices_.size()); ++i) {
+            for (vertexID vertex : regionVertices_) {
+                if (vertex == vertexOfLastUpdate_) {
+                    earlyTermination_ = true;
+                    return ReturnCode::EARLY_TERMINATION;
+                }
+
+                if (IsCancelled()) { return AbortRun(); }
+
+                if (updatedSinceLastTime_[vertex]) {
+                    RelaxOutgoingEdges<true>(vertex);
+                    updatedSinceLastTime_[vertex] = false;
+                }
+            }
+        }
+        return ReturnCode::SUCCESS;
+    }
+
     /**
      * Extracts a negative closed walk from a still relaxable edge. The walk was
      * not returned before. The edges on the walk are ordered as follows: the
      * end vertex of the first edge equals the start vertex of the second edge.
      *
-     * If no such negative closed walk exists (anymore), an empty vector is returned.
+     * If no such negative closed walk exists (anymore), walk is left empty.
      */
-    std::vector<edgeID> ExtractNegativeClosedWalk() {
-        if (earlyTermination_) return {};
+    void ExtractNegativeClosedWalk(std::vector<edgeID>& walk) {
+        walk.clear();
+        if (earlyTermination_) return;
 
         // Increment number of walks found for the current set of residual costs
         ++currentWalkIndex_;
 
-        // Implicit iteration over all edges
-        for (vertexID vertex = 0; vertex < windfarm_.NumberOfVertices(); ++vertex) {
-            edgeID relaxableEdge = FindRelaxableOutgoingEdge(vertex);
-            if (relaxableEdge != INVALID_EDGE) {
-                // There is a negative closed walk leading to relaxableEdge
-                std::vector<edgeID> walk = ExtractWalk(relaxableEdge);
-                if (!walk.empty()) {
-                    // That walk has been returned before
-                    return walk;
-                }
-                ++currentWalkIndex_;
+        if (isRestrictedToRegion_) {
+            for (vertexID vertex : regionVertices_) {
+                if (ExtractNegativeClosedWalkAt(vertex, walk)) { return; }
             }
+            return;
         }
 
-        return {};
+        // Implicit iteration over all edges
+        for (vertexID vertex = 0; vertex < windfarm_.NumberOfVertices(); ++vertex) {
+            if (ExtractNegativeClosedWalkAt(vertex, walk)) { return; }
+        }
     }
 
     /**
@@ -144,31 +180,31 @@ public:
      * either by the closedWalk or by the chain of parent pointers. In the
      * latter case, firstEdge need not be the first edge in the returned vector
      * but a simple cycle is returned. In both cases, vector[i+1] is the
-     * parent of vector[i]. If an invalid edge is found as a parent, then an
-     * empty vector is returned.
+     * parent of vector[i]. If an invalid edge is found as a parent, then walk
+     * is left empty.
      */
-    std::vector<edgeID> TraverseParentsUntilWalkStarts(std::vector<edgeID>& closedWalk, edgeID firstEdge) {
+    void TraverseParentsUntilWalkStarts(const std::vector<edgeID>& closedWalk, edgeID firstEdge, std::vector<edgeID>& walk) {
         assert(firstEdge != INVALID_EDGE);
-        
-        std::vector<edgeID> walk;
-        std::vector<bool> isVertexVisited(windfarm_.NumberOfVertices(), false);
-        std::vector<bool> isVertexOnWalk(windfarm_.NumberOfVertices(), false);
+
+        walk.clear();
+        isVertexVisited_.Clear(windfarm_.NumberOfVertices());
+        isVertexOnWalk_.Clear(windfarm_.NumberOfVertices());
         for (edgeID i : closedWalk) {
             // Visit all vertices on closedWalk
-            isVertexOnWalk[windfarm_.EndVertex(i)] = true;
+            isVertexOnWalk_.Mark(windfarm_.EndVertex(i));
         }
 
         edgeID currentEdge = firstEdge;
-        isVertexVisited[windfarm_.EndVertex(currentEdge)] = true;
+        isVertexVisited_.Mark(windfarm_.EndVertex(currentEdge));
         while (currentEdge != INVALID_EDGE) {
             walk.push_back(currentEdge);
-            if (isVertexOnWalk[windfarm_.StartVertex(currentEdge)]) {
+            if (isVertexOnWalk_.IsMarked(windfarm_.StartVertex(currentEdge))) {
                 // at this point, walk is a path between two vertices on closedWalk
                 // walk is simple because currentEdge is the first edge on walk that starts in a vertex on closedWalk and
                 // because no vertex had been repeated before.
-                return walk;
+                return;
             }
-            if (isVertexVisited[windfarm_.StartVertex(currentEdge)]) {
+            if (isVertexVisited_.IsMarked(windfarm_.StartVertex(currentEdge))) {
                 // traverse walk to front to find edge s.t. TargetVertex(edge) = StartVertex(currentEdge) and return everything in between
                 vertexID duplicateVertex = windfarm_.StartVertex(currentEdge);
                 int vectorIndexOfClosingEdge = walk.size()-1;
@@ -176,25 +212,28 @@ public:
                     vectorIndexOfClosingEdge--;
                     // cannot become negative becaue of if-condition above!
                 }
-                std::vector<edgeID> v;
-                std::copy(walk.begin()+vectorIndexOfClosingEdge, walk.end(), std::back_inserter(v));
-                assert(windfarm_.EndVertex(v.front()) == windfarm_.StartVertex(v.back()));
-                return v;
+                walk.erase(walk.begin(), walk.begin()+vectorIndexOfClosingEdge);
+                assert(windfarm_.EndVertex(walk.front()) == windfarm_.StartVertex(walk.back()));
+                return;
             } else {
-                isVertexVisited[windfarm_.StartVertex(currentEdge)] = true;
+                isVertexVisited_.Mark(windfarm_.StartVertex(currentEdge));
             }
             
             currentEdge = LabelAt(windfarm_.StartVertex(currentEdge)).Parent(windfarm_, currentEdge);
-            // if currentEdge is invalid, while-loop will be broken and an empty vector returned
+            // if currentEdge is invalid, while-loop will be broken and walk emptied
         }
-        std::vector<edgeID> empty_walk;
-        return empty_walk;
+        walk.clear();
     }
 
 
+    std::unique_ptr<NegativeCycleDetection> CreateForWindfarm(const WindfarmResidual& windfarm) const {
+        return std::make_unique<BellmanFord<LabelType>>(windfarm);
+    }
+
     const std::vector<LabelType>& Labels() const { return labels_; }
     const LabelType& LabelAt(vertexID vertex) const { return labels_[vertex]; }
-    int NumberOfIterations() const;
+    int NumberOfIterations() const { return NumberOfIterationsForVertices(windfarm_.NumberOfVertices()); }
+    int NumberOfIterationsForVertices(int numberOfVertices) const;
 
 private:
     /**
@@ -216,6 +255,55 @@ private:
         numberOfRelaxedEdgesInLastRun_ = 0;
     }
 
+    /**
+     * Ends a cancelled run. The labels are incomplete, so no walks are extracted afterwards.
+     */
+    ReturnCode AbortRun() {
+        earlyTermination_ = true;
+        return ReturnCode::TIME_LIMIT;
+    }
+
+    /**
+     * Marks the vertices of the region for the next run and clears them from
+     * labels of previous runs. Only outgoing edges of the region are touched.
+     */
+    void SetRegion(const std::vector<vertexID>& regionVertices) {
+        isRestrictedToRegion_ = true;
+        regionVertices_ = regionVertices;
+
+        isVertexInRegion_.Clear(windfarm_.NumberOfVertices());
+        for (vertexID vertex : regionVertices_) {
+            isVertexInRegion_.Mark(vertex);
+        }
+    }
+
+    bool IsInRegion(vertexID vertex) const { return isVertexInRegion_.IsMarked(vertex); }
+
+    void ResetRegion() {
+        for (vertexID vertex : regionVertices_) {
+            labels_[vertex] = LabelType();
+            updatedSinceLastTime_[vertex] = true;
+            for (edgeID edge : windfarm_.OutgoingEdges(vertex)) {
+                indexOfWalkIncluded_[edge] = 0;
+            }
+        }
+        currentWalkIndex_ = 0;
+
+        vertexOfLastUpdate_ = regionVertices_.empty() ? INVALID_VERTEX : regionVertices_.back();
+        earlyTermination_ = false;
+        numberOfRelaxedEdgesInLastRun_ = 0;
+    }
+
+    void InitializeLabelsInRegion() {
+        for (vertexID vertex : regionVertices_) {
+            for (edgeID edge : windfarm_.OutgoingEdges(vertex)) {
+                vertexID endVertex = windfarm_.EndVertex(edge);
+                if (!IsInRegion(endVertex)) continue;
+                MutableLabelAt(endVertex).Update(windfarm_.ResidualCostOnEdge(edge), edge);
+            }
+        }
+    }
+
     /**
      * Sets all labels to their initial value given by the residual costs
      */
@@ -226,11 +314,18 @@ private:
         }
     }
 
+    /**
+     * Relaxes all outgoing edges of vertex. If restrictToRegion is true,
+     * edges leaving the current region are ignored.
+     */
+    template<bool restrictToRegion>
     void RelaxOutgoingEdges(vertexID vertex) {
         bool atLeastOneUpdate = false;
         for (edgeID edge : windfarm_.OutgoingEdges(vertex)) {
             // Compute the distance to the endvertex of edge using the label at vertex
             vertexID endVertex = windfarm_.EndVertex(edge);
+            if (restrictToRegion && !IsInRegion(endVertex)) continue;
+
             double distance = LabelAt(vertex).Distance(windfarm_, edge)
                                 + windfarm_.ResidualCostOnEdge(edge);
 #ifndef NDEBUG
@@ -252,9 +347,28 @@ private:
         }
     }
 
+    /**
+     * Extracts a negative closed walk leading to a relaxable outgoing edge of vertex.
+     * Returns false and leaves walk empty if there is none or if it has been returned before.
+     */
+    bool ExtractNegativeClosedWalkAt(vertexID vertex, std::vector<edgeID>& walk) {
+        edgeID relaxableEdge = FindRelaxableOutgoingEdge(vertex);
+        if (relaxableEdge == INVALID_EDGE) { return false; }
+
+        // There is a negative closed walk leading to relaxableEdge
+        ExtractWalk(relaxableEdge, walk);
+        if (walk.empty()) {
+            // That walk has been returned before
+            ++currentWalkIndex_;
+            return false;
+        }
+        return true;
+    }
+
     /**
      * Finds a relaxable outgoing edge of a given vertex. Edges
-     * that have already been on any walk are ignored.
+     * that have already been on any walk are ignored, as are
+     * edges leaving the region during a run restricted to a region.
      */
     edgeID FindRelaxableOutgoingEdge(vertexID vertex) {
         for (edgeID edge : windfarm_.OutgoingEdges(vertex)) {
@@ -263,6 +377,7 @@ private:
             if (OnAnyWalk(edge)) continue;
 
             vertexID endVertex = windfarm_.EndVertex(edge);
+            if (isRestrictedToRegion_ && !IsInRegion(endVertex)) continue;
             double distance = LabelAt(vertex).Distance(windfarm_, edge)
                                                 + windfarm_.ResidualCostOnEdge(edge);
             if (LabelAt(endVertex).WouldUpdate(distance, edge)) {
@@ -293,10 +408,12 @@ private:
      *
      * If during the traversal of parent pointers an edge is encountered
      * that lies on any previous walk the extraction is aborted
-     * and an empty vector is returned.
+     * and walkWithoutTail is left empty.
      */
-    std::vector<edgeID> ExtractWalk(edgeID lastEdge) {
-        std::vector<edgeID> walk;
+    void ExtractWalk(edgeID lastEdge, std::vector<edgeID>& walkWithoutTail) {
+        std::vector<edgeID>& walk = reversedWalk_;
+        walk.clear();
+        walkWithoutTail.clear();
         edgeID currentEdge = lastEdge;
 
         while (!OnAnyWalk(currentEdge)) {
@@ -314,14 +431,12 @@ private:
         // If the loop is broken due to a repetition in the current walk,
         // walk includes a sequence of edges which go into a negative closed subwalk.
         // We want that closed subwalk.
-        std::vector<edgeID> walkWithoutTail;
         if (OnCurrentWalk(currentEdge)) { // while-loop was broken due to repetition of currentEdge, i.e.
                 // we have a closed walk that was not returned earlier
             auto firstOccurenceOfCurrent = std::find(walk.begin(), walk.end(), currentEdge);
             assert(firstOccurenceOfCurrent != walk.end());
             // copy walk between the first and last occurence of currentEdge. The last occurence is also the end of walk.
-            std::copy(walk.rbegin(), make_reverse_iterator(firstOccurenceOfCurrent),
-                    back_inserter(walkWithoutTail));
+            walkWithoutTail.assign(walk.rbegin(), make_reverse_iterator(firstOccurenceOfCurrent));
 
 #ifndef NDEBUG
             assert(!walkWithoutTail.empty());
@@ -336,7 +451,6 @@ private:
 #endif
 
         }
-        return walkWithoutTail;
     }
 
     /**
@@ -350,7 +464,8 @@ private:
         }
         std::cout << '\n';
 
-        auto walk = ExtractNegativeClosedWalk();
+        std::vector<edgeID> walk;
+        ExtractNegativeClosedWalk(walk);
         for (auto i : walk) {
             std::cout << " " << i << " \n";
         }
@@ -369,6 +484,20 @@ private:
     std::vector<bool> updatedSinceLastTime_;
     vertexID vertexOfLastUpdate_;
     bool earlyTermination_;
+
+    /**
+     * Vertices of the region of the last run if it was restricted to a region.
+     */
+    bool isRestrictedToRegion_;
+    std::vector<vertexID> regionVertices_;
+    Auxiliary::EpochMarks isVertexInRegion_;
+
+    /**
+     * Scratch memory reused by every walk extraction instead of allocating per call.
+     */
+    std::vector<edgeID> reversedWalk_;
+    Auxiliary::EpochMarks isVertexVisited_;
+    Auxiliary::EpochMarks isVertexOnWalk_;
     /// @}
 };
 
@@ -376,13 +505,13 @@ using SideTripFreeBellmanFord = BellmanFord<DataStructures::TwoDistancesLabel>;
 using StandardBellmanFord = BellmanFord<DataStructures::OneDistanceLabel>;
 
 template<>
-inline int SideTripFreeBellmanFord::NumberOfIterations() const {
-    return 2 * windfarm_.NumberOfVertices() - 1;
+inline int SideTripFreeBellmanFord::NumberOfIterationsForVertices(int numberOfVertices) const {
+    return 2 * numberOfVertices - 1;
 }
 
 template<>
-inline int StandardBellmanFord::NumberOfIterations() const {
-    return windfarm_.NumberOfVertices() - 1;
+inline int StandardBellmanFord::NumberOfIterationsForVertices(int numberOfVertices) const {
+    return numberOfVertices - 1;
 }
 
 } // namespace Algorithms
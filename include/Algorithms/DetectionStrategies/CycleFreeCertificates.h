@@ -0,0 +1,93 @@
+#ifndef ALGORITHMS_DETECTIONSTRATEGIES_CYCLEFREECERTIFICATES
+#define ALGORITHMS_DETECTIONSTRATEGIES_CYCLEFREECERTIFICATES
+
+#include <cassert>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "Algorithms/ResidualCosts/StandardResidualCostComputer.h"
+
+#include "DataStructures/Graphs/WindfarmResidual.h"
+
+namespace wcp {
+
+namespace Algorithms {
+
+/**
+ * Remembers for which deltas a detection run has proven that the residual graph
+ * with standard residual costs contains no negative closed walk.
+ *
+ * A certificate records the flow version of the windfarm at the time of the proof.
+ * If no flow change since then has decreased the residual cost of an edge for
+ * that delta (where an infinite cost means the edge is missing), every closed walk
+ * is at least as expensive as before, so there is still no negative one. The flow
+ * changes are taken from the change log of the windfarm. If they are no longer
+ * recorded, the certificate is dropped.
+ */
+class CycleFreeCertificates {
+public:
+    CycleFreeCertificates(DataStructures::WindfarmResidual& windfarm, int maximumFlowChange)
+      : windfarm_(windfarm),
+        residualCostComputer_(windfarm),
+        hasCertificate_(maximumFlowChange + 1, false),
+        versionOfCertificate_(maximumFlowChange + 1, 0) {}
+
+    /**
+     * Records that the current residual graph for delta contains no negative closed walk.
+     */
+    void Issue(int delta) {
+        assert(IsValidDelta(delta));
+        hasCertificate_[delta] = true;
+        versionOfCertificate_[delta] = windfarm_.FlowVersion();
+    }
+
+    /**
+     * Returns whether the current residual graph for delta is still known to contain no negative closed walk.
+     * A valid certificate is moved to the current flow version so that later checks start from here.
+     */
+    bool IsValid(int delta) {
+        if (!IsValidDelta(delta) || !hasCertificate_[delta]) { return false; }
+
+        std::uint64_t currentVersion = windfarm_.FlowVersion();
+        for (std::uint64_t version = versionOfCertificate_[delta] + 1; version <= currentVersion; ++version) {
+            if (!windfarm_.IsFlowChangeRecorded(version) || DecreasesResidualCosts(windfarm_.FlowChangeAt(version), delta)) {
+                hasCertificate_[delta] = false;
+                return false;
+            }
+        }
+
+        versionOfCertificate_[delta] = currentVersion;
+        return true;
+    }
+
+private:
+    bool IsValidDelta(int delta) const {
+        return delta > 0 && static_cast<size_t>(delta) < hasCertificate_.size();
+    }
+
+    bool DecreasesResidualCosts(const DataStructures::FlowChange& change, int delta) const {
+        std::pair<edgeID, edgeID> edges = windfarm_.EdgesOfFlowSlot(change.slot);
+        return DecreasesResidualCost(edges.first, change.previousFlow, change.newFlow, delta)
+                || DecreasesResidualCost(edges.second, -change.previousFlow, -change.newFlow, delta);
+    }
+
+    bool DecreasesResidualCost(edgeID edge, int previousFlow, int newFlow, int delta) const {
+        double previousCost = residualCostComputer_.ResidualCostForFlow(edge, previousFlow, delta);
+        double newCost = residualCostComputer_.ResidualCostForFlow(edge, newFlow, delta);
+        // Exact comparison: small decreases on several edges can add up to a negative cycle
+        return newCost < previousCost;
+    }
+
+    const DataStructures::WindfarmResidual& windfarm_;
+    StandardResidualCostComputer residualCostComputer_;
+
+    std::vector<bool> hasCertificate_;
+    std::vector<std::uint64_t> versionOfCertificate_;
+};
+
+} // namespace Algorithms
+
+} // namespace wcp
+
+#endif
@@ -0,0 +1,70 @@
+#ifndef ALGORITHMS_DETECTIONSTRATEGIES_HOPNEIGHBORHOOD
+#define ALGORITHMS_DETECTIONSTRATEGIES_HOPNEIGHBORHOOD
+
+#include <algorithm>
+#include <vector>
+
+#include "Auxiliary/EpochMarks.h"
+
+#include "DataStructures/Graphs/WindfarmResidual.h"
+
+namespace wcp {
+
+namespace Algorithms {
+
+/**
+ * Collects all vertices within a given number of hops of a set of seed vertices
+ * in the residual graph. The supersubstation is included if it is reached, but
+ * it is not expanded since every substation is its neighbor.
+ */
+class HopNeighborhood {
+public:
+    HopNeighborhood(const DataStructures::WindfarmResidual& windfarm)
+      : windfarm_(windfarm),
+        hops_(windfarm.NumberOfVertices(), 0) {}
+
+    /**
+     * Runs a breadth-first search from seeds that stops after numberOfHops hops.
+     * Afterwards, Vertices() contains the visited vertices in increasing order.
+     */
+    void Collect(const std::vector<vertexID>& seeds, unsigned int numberOfHops) {
+        isVertexVisited_.Clear(windfarm_.NumberOfVertices());
+        vertices_.clear();
+        for (vertexID seed : seeds) {
+            Visit(seed, 0);
+        }
+
+        // vertices_ doubles as the queue of the breadth-first search
+        for (size_t i = 0; i < vertices_.size(); ++i) {
+            vertexID vertex = vertices_[i];
+            if (hops_[vertex] == numberOfHops || vertex == windfarm_.SuperSubstationIdentifier()) continue;
+            for (edgeID edge : windfarm_.OutgoingEdges(vertex)) {
+                Visit(windfarm_.EndVertex(edge), hops_[vertex] + 1);
+            }
+        }
+
+        std::sort(vertices_.begin(), vertices_.end());
+    }
+
+    const std::vector<vertexID>& Vertices() const { return vertices_; }
+
+private:
+    void Visit(vertexID vertex, unsigned int hops) {
+        if (isVertexVisited_.IsMarked(vertex)) return;
+        isVertexVisited_.Mark(vertex);
+        hops_[vertex] = hops;
+        vertices_.push_back(vertex);
+    }
+
+    const DataStructures::WindfarmResidual& windfarm_;
+
+    std::vector<unsigned int> hops_;
+    Auxiliary::EpochMarks isVertexVisited_;
+    std::vector<vertexID> vertices_;
+};
+
+} // namespace Algorithms
+
+} // namespace wcp
+
+#endif
@@ -1,10 +1,12 @@
 #ifndef ALGORITHMS_DETECTIONSTRATEGIES_NEGATIVECYCLEDETECTION
 #define ALGORITHMS_DETECTIONSTRATEGIES_NEGATIVECYCLEDETECTION
 
+#include <memory>
 #include <vector>
 
+#include "Auxiliary/CancellationToken.h"
 #include "Auxiliary/ReturnCodes.h"
-#include "DataStructures/Graphs/Windfarm.h" // for vertexID, edgeID
+#include "DataStructures/Graphs/WindfarmResidual.h"
 
 namespace wcp {
 
@@ -22,27 +24,49 @@ public:
      * no negative closed walk in the graph. Otherwise, ReturnCode::SUCCESS
      * is returned. In that case, a negative walk may or may not exist. If it
      * does, it can be retrieved using ExtractNegativeClosedWalk().
+     * If the cancellation token is cancelled during the run, ReturnCode::TIME_LIMIT
+     * is returned and no walk can be extracted.
      */
     virtual ReturnCode Run() = 0;
 
+    /**
+     * Runs the negative walk detection on the subgraph induced by regionVertices.
+     * Return values are as for Run(), but only refer to the region. Afterwards,
+     * ExtractNegativeClosedWalk() only returns walks within the region until
+     * Run() is called again.
+     */
+    virtual ReturnCode RunOnRegion(const std::vector<vertexID>& regionVertices) = 0;
+
     /**
      * Extracts a negative closed walk, in which the edges are ordered
      * as in the graph, i.e., the end vertex of the first edge
      * equals the start vertex of the second edge.
      *
-     * If no such negative closed walk exists, an empty vector is returned.
+     * The walk is written to walk, whose memory is reused across calls.
+     * If no such negative closed walk exists, walk is left empty.
      */
-    virtual std::vector<edgeID> ExtractNegativeClosedWalk() = 0;
+    virtual void ExtractNegativeClosedWalk(std::vector<edgeID>& walk) = 0;
     virtual std::vector<edgeID> TraverseParentsUntilParticularEdgeRepeats(vertexID vertexToStartFrom) = 0;
-    virtual std::vector<edgeID> TraverseParentsUntilWalkStarts(std::vector<edgeID>& closedWalk, edgeID firstEdge) = 0;
+    virtual void TraverseParentsUntilWalkStarts(const std::vector<edgeID>& closedWalk, edgeID firstEdge, std::vector<edgeID>& walk) = 0;
     virtual void Print() = 0;
 
+    /**
+     * Creates a detection strategy of the same kind that works on another windfarm,
+     * e.g., a copy on which a subproblem is solved in parallel.
+     */
+    virtual std::unique_ptr<NegativeCycleDetection> CreateForWindfarm(const DataStructures::WindfarmResidual& windfarm) const = 0;
+
     size_t NumberOfRelaxedEdgesInLastRun() const { return numberOfRelaxedEdgesInLastRun_; }
 
+    void SetCancellationToken(Auxiliary::CancellationToken* cancellationToken) { cancellationToken_ = cancellationToken; }
+
     virtual ~NegativeCycleDetection() = default;
 
 protected:
+    bool IsCancelled() { return cancellationToken_ != nullptr && cancellationToken_->IsCancelledAfterManyCalls(); }
+
     size_t numberOfRelaxedEdgesInLastRun_ = 0;
+    Auxiliary::CancellationToken* cancellationToken_ = nullptr;
 };
 
 } // namespace Algorithms
@@ -11,6 +11,7 @@
 
 #include "DataStructures/Graphs/WindfarmResidual.h"
 
+#include "Auxiliary/CancellationToken.h"
 #include "Auxiliary/ReturnCodes.h"
 #include "Auxiliary/Constants.h"
 
@@ -38,7 +39,8 @@ public:
         lastFreeSubstationSettled_(INVALID_VERTEX),
         dist_(windfarm.NumberOfVertices(), Auxiliary::DINFTY),
         parent_(windfarm.NumberOfVertices(), INVALID_VERTEX),
-        queue_() {}
+        queue_(),
+        cancellationToken_(nullptr) {}
 
     /**
      * Runs the shortest path computation.
@@ -47,7 +49,7 @@ public:
      * vertex that was found. In particular, if one searches for a substation
      * with free capacity, TargetVertex() contains the closest such substation.
      * Returns ReturnCode::Success if the target was found, ReturnCode::Infeasible
-     * otherwise.
+     * otherwise, and ReturnCode::TIME_LIMIT if the cancellation token was cancelled.
      */
     ReturnCode Run();
 
@@ -66,6 +68,8 @@ public:
     bool      IsAnyFreeSubstationTarget() const { return targetVertex_ == ANY_FREE_SUBSTATION; }
     bool      IsLastFreeSubstationTarget() const { return targetVertex_ == LAST_FREE_SUBSTATION; }
 
+    void SetCancellationToken(Auxiliary::CancellationToken* cancellationToken) { cancellationToken_ = cancellationToken; }
+
     static const vertexID ANY_FREE_SUBSTATION = std::numeric_limits<vertexID>::max();
     static const vertexID LAST_FREE_SUBSTATION = std::numeric_limits<vertexID>::max() - 1;
 
@@ -150,6 +154,8 @@ private:
     std::vector<double> dist_; // Contains the currently known shortest distance from the start vertex.
     std::vector<edgeID> parent_;
     QueueType queue_;
+
+    Auxiliary::CancellationToken* cancellationToken_;
 };
 
 } // namespace Algorithms
@@ -28,7 +28,11 @@ public:
 private:
     void SetIncomingBonbonEdgeForVertex(edgeID edgeInBonbon);
 
-    void RecoverBonbon(EscapingNCC& ncc);
+    /**
+     * Recomputes the labels from which the bonbon stored in ncc was extracted and
+     * stores it in bonbon_. Returns ReturnCode::TIME_LIMIT if the detection run was cancelled.
+     */
+    ReturnCode RecoverBonbon(EscapingNCC& ncc);
 
     ReturnCode SpecialTreatmentIfTailIsClosed(EscapingNCC& ncc, std::vector<edgeID>& tail, double costOfTail);
 
@@ -40,6 +44,7 @@ private:
 
     std::vector<edgeID> bonbon_;
     std::vector<edgeID> firstEdgeInWalkLeadingToVertex_;
+    std::vector<edgeID> tail_; // reused for every incoming edge in CheckAllIncomingEdgesForTail
 };
 
 } // namespace Algorithms
@@ -5,6 +5,7 @@
 #include <queue>
 #include <vector>
 
+#include "Auxiliary/EpochMarks.h"
 #include "Auxiliary/ReturnCodes.h"
 
 #include "Algorithms/EscapeStrategies/EscapingStrategy.h"
@@ -90,15 +91,15 @@ private:
 
     edgeID SingleDFSStepToFindPathToRepeatingEdge(edgeID edgeToRepeat, edgeID edgeToExplore, bool& hasEdgeToRepeatAlreadyBeenSeen, std::vector<edgeID>& NextEdgeToASubstation);
 
-    std::vector<edgeID> PopulateParentPointersUntilEdgeRepeats(edgeID edgeToRepeat, edgeID edgeToStartSearchWith);
+    void PopulateParentPointersUntilEdgeRepeats(edgeID edgeToRepeat, edgeID edgeToStartSearchWith);
 
     void CancelCycleWithAllPositiveFlow(edgeID edgeOnCycle, edgeID firstEdgeInSearch);
 
-    edgeID ExploreEdgeWhenFindingPreviousSubstation(std::vector<bool>& hasEdgeAlreadyBeenExplored, std::vector<edgeID>& invertedPathToPreviousSubstation, edgeID edgeToExplore, edgeID firstEdgeInSearch);
+    edgeID ExploreEdgeWhenFindingPreviousSubstation(Auxiliary::EpochMarks& hasEdgeAlreadyBeenExplored, std::vector<edgeID>& invertedPathToPreviousSubstation, edgeID edgeToExplore, edgeID firstEdgeInSearch);
 
     std::vector<edgeID> IdentifyInvertedPathToPreviousSubstation(LeafTurbine& leaf);
 
-    edgeID ExploreEdgeWhenFindingNewSubstation(std::vector<bool>& hasEdgeAlreadyBeenExplored, std::vector<edgeID>& invertedPathToNewSubstation, edgeID edgeToExplore, edgeID firstEdgeInSearch, vertexID previousSubstation);
+    edgeID ExploreEdgeWhenFindingNewSubstation(Auxiliary::EpochMarks& hasEdgeAlreadyBeenExplored, std::vector<edgeID>& invertedPathToNewSubstation, edgeID edgeToExplore, edgeID firstEdgeInSearch, vertexID previousSubstation);
 
     std::vector<edgeID> IdentifyInvertedPathToNewSubstation(LeafTurbine& leaf, vertexID previousSubstation);
 
@@ -122,6 +123,13 @@ private:
 
     std::vector<std::vector<vertexID>> mappingTurbinesToSubstations_;
     std::vector<LeafTurbine> potentialLeaves_;
+
+    /**
+     * Scratch memory of the searches from a leaf, reused for all leaves. Entries of
+     * nextEdgeToASubstation_ are only read along the path written by the current search.
+     */
+    Auxiliary::EpochMarks hasEdgeAlreadyBeenExplored_;
+    std::vector<edgeID> nextEdgeToASubstation_;
 };
 
 } // namespace Algorithms
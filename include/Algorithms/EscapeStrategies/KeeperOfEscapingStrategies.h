@@ -3,8 +3,11 @@
 
 #include <cassert>
 #include <limits>
+#include <istream>
 #include <memory>
+#include <ostream>
 #include <random>
+#include <string>
 #include <vector>
 
 #include "Algorithms/EscapeStrategies/EscapingStrategy.h"
@@ -83,8 +86,49 @@ public:
         numberOfStrategiesUsedUnsuccessfully_++;
     }
 
+    /**
+     * Makes all strategies available again, e.g., after the flow has been replaced from outside.
+     */
+    void ResetTracking() {
+        iterationOfLastChange_ = *currentIteration_;
+        numberOfStrategiesUsedUnsuccessfully_ = 0;
+    }
+
     bool HaveAllStrategiesBeenUsedInCurrentIteration() { return numberOfStrategiesUsedUnsuccessfully_ == iterationOfLastUse_.size(); }
 
+    /**
+     * Writes the random number generator and the usage tracking, so that a run
+     * resumed from a checkpoint draws the same strategies.
+     */
+    void WriteState(std::ostream& os) const {
+        os << rng_ << ' ' << iterationOfLastUse_.size();
+        for (unsigned int iteration : iterationOfLastUse_) {
+            os << ' ' << iteration;
+        }
+        os << ' ' << numberOfStrategiesUsedUnsuccessfully_
+           << ' ' << iterationOfLastChange_
+           << ' ' << indexOfCurrentEscapingStrategy_;
+    }
+
+    /**
+     * Reads a state written by WriteState. Must be called after InitializeRNGandTracking.
+     */
+    void ReadState(std::istream& is) {
+        size_t numberOfStrategies = 0;
+        is >> rng_ >> numberOfStrategies;
+        if (!is || numberOfStrategies != iterationOfLastUse_.size()) {
+            throw std::string("The escaping strategies of the checkpoint do not match the chosen ones.");
+        }
+        for (unsigned int& iteration : iterationOfLastUse_) {
+            is >> iteration;
+        }
+        is >> numberOfStrategiesUsedUnsuccessfully_ >> iterationOfLastChange_ >> indexOfCurrentEscapingStrategy_;
+        if (!is) {
+            throw std::string("Could not read the state of the escaping strategies from the checkpoint.");
+        }
+        assert(CheckConsistency());
+    }
+
 private:
     std::vector<std::pair<std::unique_ptr<EscapingStrategy>, unsigned int>> vectorOfEscapingStrategiesWithWeights;
 
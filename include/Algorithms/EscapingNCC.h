@@ -4,6 +4,8 @@
 #include <cassert>
 #include <memory>
 #include <ostream>
+#include <sstream>
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -14,6 +16,8 @@
 #include "Algorithms/ResidualCosts/EscapingResidualCostComputer.h"
 #include "Algorithms/ResidualCosts/SpecializedResidualCosts.h"
 #include "Algorithms/NegativeCycleCanceling.h"
+#include "Algorithms/NCCSettings.h"
+#include "Algorithms/SharedIncumbent.h"
 
 #include "Auxiliary/Constants.h"
 #include "Auxiliary/ReturnCodes.h"
@@ -21,6 +25,7 @@
 #include "DataStructures/Graphs/WindfarmResidual.h"
 #include "DataStructures/Instance.h"
 
+#include "IO/Checkpoint.h"
 #include "IO/NCCLogger.h"
 
 namespace wcp {
@@ -62,7 +67,9 @@ public:
                 unsigned int iterationLimit,
                 bool beVerbose,
                 std::ostream& verboseStream = std::cout,
-                double maxRunningTimeInMilliseconds = Auxiliary::DINFTY)
+                double maxRunningTimeInMilliseconds = Auxiliary::DINFTY,
+                SharedIncumbent* sharedIncumbent = nullptr,
+                const NCCSettings& settings = NCCSettings())
       : NegativeCycleCanceling( instance,
                                 windfarm,
                                 logger,
@@ -72,18 +79,25 @@ public:
                                 seedInput,
                                 beVerbose,
                                 verboseStream,
-                                maxRunningTimeInMilliseconds),
+                                maxRunningTimeInMilliseconds,
+                                settings),
         keeperOfEscapingStrategies_(std::move(keeperOfEscapingStrategies)),
         iterationLimit_(iterationLimit),
         bestFlow_(windfarm_.NumberOfEdges(), Auxiliary::INFINITE_CAPACITY),
+        bestFlowMark_(0),
         bestSolutionValue_(Auxiliary::INFINITE_COST),
         residualCostComputer_(windfarm),
-        runs_(0)
+        runs_(0),
+        sharedIncumbent_(sharedIncumbent),
+        checkpointWriter_(settings.checkpointFile.empty() ? nullptr : std::make_unique<IO::CheckpointWriter>(settings.checkpointFile)),
+        lastCheckpointInMilliseconds_(0)
     {
         InferSettingsFromEscapingStrategies();
 
         InitializeKeeperOfEscapingStrategies(seedInput);
 
+        // bestFlowMark_ refers to a journal started by this run, not to one left open by an earlier run on windfarm
+        windfarm_.CommitFlow();
         RunCompleteAlgorithm();
     }
 
@@ -113,17 +127,27 @@ private:
     virtual StandardResidualCostComputer& ResidualCostComputer() { return residualCostComputer_; }
 
     ReturnCode RunCompleteAlgorithm() {
-        ReturnCode valueForReturn = ComputeInitialFlow();
+        ReturnCode valueForReturn;
+        if (settings_.resumeFile.empty()) {
+            valueForReturn = ComputeInitialFlow();
+            runs_ = 1; // the first run is NCC only, after that a run is Escaping+NCC
+        } else {
+            valueForReturn = ResumeFromCheckpoint(IO::ReadCheckpoint(settings_.resumeFile));
+        }
 
         if (valueForReturn == ReturnCode::SUCCESS && iterationLimit_ == 0) {
             valueForReturn = ReturnCode::ITERATION_LIMIT;
         }
 
-        runs_ = 1; // the first run is NCC only, after that a run is Escaping+NCC
-
         if (valueForReturn == ReturnCode::SUCCESS) {
             valueForReturn = AlternateNCCandEscaping();
+            if (valueForReturn == ReturnCode::TIME_LIMIT) {
+                // Interrupted runs can be continued from here
+                WriteCheckpointIfDue(true);
+            }
             CopyBestFlowToWindfarm();
+            windfarm_.CommitFlow(); // nothing is rolled back after the run
+            StreamIncumbent(true);
         }
 
         logger_.CompleteSummaryWithInformationFromAlgorithmRun(windfarm_.ComputeTotalCostOfFlow(), valueForReturn);
@@ -134,6 +158,7 @@ private:
         ReturnCode valueForReturn = ReturnCode::IN_PROGRESS;
 
         while (valueForReturn == ReturnCode::IN_PROGRESS) {
+            WriteCheckpointIfDue();
             if (beVerbose_) {
                 verboseStream_ << "Start iteration with number " << runs_ << ".\n";
                 residualCostComputer_.OutputAdaptations(verboseStream_);
@@ -154,6 +179,10 @@ private:
 
             // NCC run is complete. Unless the time limit is exceeded or iteration limit is saturated, start escaping.
             valueForReturn = TryToChangeFlowByApplyingEscapingStrategies(realSolutionCostsWithoutChanges);
+
+            if (valueForReturn == ReturnCode::EARLY_TERMINATION && RestartFromSharedIncumbentIfBetter()) {
+                valueForReturn = ReturnCode::IN_PROGRESS;
+            }
         }
 
         return valueForReturn;
@@ -180,7 +209,9 @@ private:
             } else {
                 valueForReturn = keeperOfEscapingStrategies_->ApplyCurrentStrategy(*this);
 
-                if (valueForReturn == ReturnCode::SUCCESS) {
+                if (valueForReturn == ReturnCode::TIME_LIMIT) {
+                    return ReturnCode::TIME_LIMIT;
+                } else if (valueForReturn == ReturnCode::SUCCESS) {
                     DoBookkeepingAfterSuccessfulEscaping();
                     if (beVerbose_) {
                         verboseStream_ << "Escaping strategy " << keeperOfEscapingStrategies_->NameOfCurrentStrategy() << " successful.\n\n";
@@ -230,6 +261,108 @@ private:
         }
     }
 
+    /**
+     * Passes the current state to the checkpoint writer if the checkpoint interval
+     * has elapsed or force is set. Only copying the state happens on this thread.
+     */
+    void WriteCheckpointIfDue(bool force = false) {
+        if (checkpointWriter_ == nullptr) { return; }
+        double elapsedMilliseconds = Timer.ElapsedMilliseconds();
+        if (!force && elapsedMilliseconds - lastCheckpointInMilliseconds_ < settings_.checkpointIntervalInMilliseconds) { return; }
+        lastCheckpointInMilliseconds_ = elapsedMilliseconds;
+
+        IO::EscapingCheckpoint checkpoint;
+        checkpoint.flowInSlots.reserve(windfarm_.NumberOfOriginalEdges() + windfarm_.NumberOfSubstations());
+        for (edgeID edge = 0; edge < windfarm_.NumberOfOriginalEdges(); ++edge) {
+            checkpoint.flowInSlots.push_back(windfarm_.FlowOnEdge(edge));
+        }
+        for (int i = 0; i < windfarm_.NumberOfSubstations(); ++i) {
+            checkpoint.flowInSlots.push_back(windfarm_.FlowOnEdge(SubstationEdge(i)));
+        }
+        checkpoint.bestFlow = bestFlow_;
+        checkpoint.bestSolutionValue = bestSolutionValue_;
+        checkpoint.solutionCosts = solutionCosts_;
+        checkpoint.runs = runs_;
+        checkpoint.bonbonChangeOfFlow = bonbon_.changeOfFlow;
+        checkpoint.bonbonEdge = bonbon_.edgeOnBonbon;
+        for (auto&& adaptedCost : residualCostComputer_.AdaptedResidualCosts().showVector()) {
+            checkpoint.adaptedResidualCosts.emplace_back(adaptedCost.edgeWithSpecialCosts, adaptedCost.cables.ExpandedCosts());
+        }
+        checkpoint.verticesOnCanceledCycles = verticesOnCanceledCycles_;
+        checkpoint.localDetectionRegion = localDetectionRegion_;
+
+        std::ostringstream escapingState;
+        keeperOfEscapingStrategies_->WriteState(escapingState);
+        checkpoint.stateOfEscapingStrategies = escapingState.str();
+        std::ostringstream deltaState;
+        deltaStrategy_->WriteState(deltaState);
+        checkpoint.stateOfDeltaStrategy = deltaState.str();
+
+        checkpointWriter_->Submit(std::move(checkpoint));
+    }
+
+    /**
+     * Restores the state of a checkpoint instead of computing an initial flow.
+     * Throws a string if the checkpoint does not fit the instance.
+     */
+    ReturnCode ResumeFromCheckpoint(const IO::EscapingCheckpoint& checkpoint) {
+        const size_t numberOfSlots = windfarm_.NumberOfOriginalEdges() + windfarm_.NumberOfSubstations();
+        if (checkpoint.flowInSlots.size() != numberOfSlots || checkpoint.bestFlow.size() != bestFlow_.size()) {
+            throw std::string("The checkpoint does not belong to this instance.");
+        }
+#ifndef NDEBUG
+        AssertZeroFlow(windfarm_);
+#endif
+
+        Timer.Restart();
+        for (edgeID edge = 0; edge < windfarm_.NumberOfOriginalEdges(); ++edge) {
+            windfarm_.SetFlowOnEdge(edge, checkpoint.flowInSlots[edge]);
+        }
+        for (int i = 0; i < windfarm_.NumberOfSubstations(); ++i) {
+            windfarm_.SetFlowOnEdge(SubstationEdge(i), checkpoint.flowInSlots[windfarm_.NumberOfOriginalEdges() + i]);
+        }
+#ifndef NDEBUG
+        AssertFeasibleFlow(windfarm_);
+#endif
+
+        bestFlow_ = checkpoint.bestFlow;
+        windfarm_.CommitFlow(); // the flow in the windfarm is not bestFlow_
+        bestSolutionValue_ = checkpoint.bestSolutionValue;
+        solutionCosts_ = checkpoint.solutionCosts;
+        runs_ = checkpoint.runs;
+        bonbon_.changeOfFlow = checkpoint.bonbonChangeOfFlow;
+        bonbon_.edgeOnBonbon = checkpoint.bonbonEdge;
+
+        SpecialResidualCostCollection adaptedResidualCosts;
+        const size_t lengthOfCostVector = 2 * windfarm_.Cabletypes().MaximumCapacity() + 1;
+        for (auto&& adaptedCost : checkpoint.adaptedResidualCosts) {
+            if (adaptedCost.first < 0 || adaptedCost.first >= windfarm_.NumberOfEdges() || adaptedCost.second.size() != lengthOfCostVector) {
+                throw std::string("The checkpoint does not belong to this instance.");
+            }
+            adaptedResidualCosts.addEdge(adaptedCost.first, adaptedCost.second);
+        }
+        CopyAdaptedResidualCosts(adaptedResidualCosts);
+        verticesOnCanceledCycles_ = checkpoint.verticesOnCanceledCycles;
+        localDetectionRegion_ = checkpoint.localDetectionRegion;
+
+        std::istringstream escapingState(checkpoint.stateOfEscapingStrategies);
+        keeperOfEscapingStrategies_->ReadState(escapingState);
+        std::istringstream deltaState(checkpoint.stateOfDeltaStrategy);
+        deltaStrategy_->ReadState(deltaState);
+
+        lastCheckpointInMilliseconds_ = Timer.ElapsedMilliseconds();
+        logger_.FillSummaryWithInitializationInformation(lastCheckpointInMilliseconds_, solutionCosts_, ReturnCode::SUCCESS);
+
+        if (beVerbose_) {
+            verboseStream_ << "Resume from checkpoint in iteration " << runs_ << " with cost " << solutionCosts_ << ".\n\n";
+        }
+        return ReturnCode::SUCCESS;
+    }
+
+    edgeID SubstationEdge(int i) const {
+        return 2 * windfarm_.NumberOfOriginalEdges() + i;
+    }
+
     void InitializeKeeperOfEscapingStrategies(int seedInput) {
         keeperOfEscapingStrategies_->InitializeRNGandTracking(runs_, seedInput);
     }
@@ -283,25 +416,94 @@ private:
     void UpdateBestFlow(double newBestCost) {
         bestSolutionValue_ = newBestCost;
         CopyBestFlowFromWindfarm();
+
+        if (sharedIncumbent_ != nullptr) {
+            sharedIncumbent_->Offer(bestSolutionValue_, bestFlow_);
+        }
+
+        StreamIncumbent();
     }
 
+    /**
+     * The incumbent is the best flow, since the current flow may be worse after escaping.
+     */
+    double IncumbentCost() override { return bestSolutionValue_; }
+    int IncumbentFlowOnEdge(edgeID edge) override { return bestFlow_[edge]; }
+
+    /**
+     * Called when this chain is stuck, i.e., no escaping strategy has been successful.
+     * If another chain has found a strictly better flow, continue from that flow.
+     */
+    bool RestartFromSharedIncumbentIfBetter() {
+        if (sharedIncumbent_ == nullptr) { return false; }
+        if (sharedIncumbent_->BestCost() >= bestSolutionValue_ - Auxiliary::DOUBLE_ROUNDING_PRECISION) { return false; }
+
+        std::shared_ptr<const IncumbentSnapshot> incumbent = sharedIncumbent_->Load();
+        if (incumbent->cost >= bestSolutionValue_ - Auxiliary::DOUBLE_ROUNDING_PRECISION) { return false; }
+        assert(incumbent->flow.size() == bestFlow_.size());
+
+        double previousCostValueForCostChangeComputation = solutionCosts_;
+        bestSolutionValue_ = incumbent->cost;
+        bestFlow_ = incumbent->flow;
+        windfarm_.CommitFlow(); // the journal leads back to our own best flow
+        CopyBestFlowToWindfarm();
+        ClearListOfAdaptedResidualCosts();
+        solutionCosts_ = windfarm_.ComputeTotalCostOfFlow();
+
+        keeperOfEscapingStrategies_->ResetTracking();
+
+        logger_.SaveRuntimeDataAfterHalfIteration("Restart",
+                                            Timer.ElapsedMilliseconds(),
+                                            solutionCosts_,
+                                            solutionCosts_ - previousCostValueForCostChangeComputation,
+                                            ReturnCode::SUCCESS);
+        if (beVerbose_) {
+            verboseStream_ << "Restart from the shared best flow with cost " << solutionCosts_ << ".\n\n";
+        }
+        return true;
+    }
+
+    /**
+     * The flow journal of the windfarm starts at bestFlowMark_ when bestFlow_ is copied,
+     * so both copies only touch the edges whose flow changed in between unless the
+     * journal has given up.
+     */
     void CopyBestFlowFromWindfarm() {
         assert(bestFlow_.size() == static_cast<size_t>(windfarm_.NumberOfEdges()));
-        for (int edge = 0; edge < windfarm_.NumberOfEdges(); edge++) {
-            bestFlow_[edge] = windfarm_.FlowOnEdge(edge);
+        if (windfarm_.CanRollbackFlowTo(bestFlowMark_)) {
+            const std::vector<DataStructures::FlowChange>& journal = windfarm_.FlowJournal();
+            for (auto change = journal.begin() + bestFlowMark_; change != journal.end(); ++change) {
+                std::pair<edgeID, edgeID> edges = windfarm_.EdgesOfFlowSlot(change->slot);
+                bestFlow_[edges.first] = windfarm_.FlowOnEdge(edges.first);
+                bestFlow_[edges.second] = windfarm_.FlowOnEdge(edges.second);
+            }
+        } else {
+            for (int edge = 0; edge < windfarm_.NumberOfEdges(); edge++) {
+                bestFlow_[edge] = windfarm_.FlowOnEdge(edge);
+            }
         }
+        windfarm_.CommitFlow();
+        bestFlowMark_ = windfarm_.MarkFlow();
     }
 
     void CopyBestFlowToWindfarm() {
         assert(bestFlow_.size() == static_cast<size_t>(windfarm_.NumberOfEdges()));
-        for (int edge = 0; edge < windfarm_.NumberOfEdges(); edge++) {
-            windfarm_.SetFlowOnEdge(edge, bestFlow_[edge]);
+        if (windfarm_.CanRollbackFlowTo(bestFlowMark_)) {
+            windfarm_.RollbackFlow(bestFlowMark_);
+        } else {
+            for (int edge = 0; edge < windfarm_.NumberOfEdges(); edge++) {
+                windfarm_.SetFlowOnEdge(edge, bestFlow_[edge]);
+            }
         }
+        windfarm_.CommitFlow();
+        bestFlowMark_ = windfarm_.MarkFlow();
     }
 
     void WriteBestFlowToStream(std::ostream& os) {
         os << "A new best flow has been found. Flow values are: ";
-        for (int edge = 0; edge < windfarm_.NumberOfOriginalEdges(); edge++) {
+        // In the numbering of the input file, unless the topology has been edited
+        for (int originalEdge = 0; originalEdge < windfarm_.NumberOfOriginalEdges(); originalEdge++) {
+            edgeID edge = windfarm_.HasEditedTopology() ? originalEdge : instance_.EdgeIndexOfOriginalEdge(originalEdge);
             os << bestFlow_[edge] << " ";
         }
         os << "\n";
@@ -333,10 +535,16 @@ private:
     std::unique_ptr<KeeperOfEscapingStrategies> keeperOfEscapingStrategies_;
     unsigned int iterationLimit_;
     std::vector<int> bestFlow_;
+    std::size_t bestFlowMark_;
     double bestSolutionValue_;
     ResidualCostComputerWithAdaptedEdges residualCostComputer_;
 
     unsigned int runs_;
+
+    SharedIncumbent* sharedIncumbent_;
+
+    std::unique_ptr<IO::CheckpointWriter> checkpointWriter_;
+    double lastCheckpointInMilliseconds_;
 };
 
 } // namespace Algorithms
@@ -0,0 +1,73 @@
+#ifndef ALGORITHMS_INITIALIZATIONSTRATEGIES_FLOWFROMFILE
+#define ALGORITHMS_INITIALIZATIONSTRATEGIES_FLOWFROMFILE
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "Algorithms/InitializationStrategies/InitializationStrategy.h"
+
+#include "Auxiliary/ReturnCodes.h"
+
+#include "DataStructures/Graphs/WindfarmResidual.h"
+
+namespace wcp {
+
+namespace Algorithms {
+
+/**
+ * Initialization strategy that starts from a given flow on the original edges,
+ * e.g., a previous solution of the same wind farm (see IO::FlowFile). The flow into
+ * each substation is derived from the flow on its edges. Throws a string if the
+ * flow does not fit the wind farm or is infeasible.
+ */
+struct FlowFromFile : public InitializationStrategy {
+public:
+    FlowFromFile(WindfarmResidual& windfarm, std::vector<int> flowOnOriginalEdges)
+    : InitializationStrategy(windfarm, nullptr, INVALID_VERTEX),
+      flowOnOriginalEdges_(std::move(flowOnOriginalEdges)) {}
+
+    ReturnCode InitializeFlow() override {
+        if (flowOnOriginalEdges_.size() != static_cast<size_t>(Windfarm().NumberOfOriginalEdges())) {
+            throw "The given flow has " + std::to_string(flowOnOriginalEdges_.size()) + " edges, but the wind farm has "
+                    + std::to_string(Windfarm().NumberOfOriginalEdges()) + ".";
+        }
+
+        for (edgeID edge = 0; edge < Windfarm().NumberOfOriginalEdges(); ++edge) {
+            Windfarm().SetFlowOnEdge(edge, flowOnOriginalEdges_[edge]);
+        }
+
+        for (vertexID substation : Windfarm().Substations()) {
+            int flowFromTurbines = 0;
+            for (edgeID edge : Windfarm().OutgoingEdges(substation)) {
+                if (edge < 2 * Windfarm().NumberOfOriginalEdges()) {
+                    flowFromTurbines -= Windfarm().FlowOnEdge(edge);
+                }
+            }
+            Windfarm().SetFlowOnEdge(Windfarm().EdgeToSupersubstation(substation), flowFromTurbines);
+        }
+
+        std::string violation = FeasibilityViolation(Windfarm());
+        if (!violation.empty()) {
+            throw "The given flow is infeasible. " + violation;
+        }
+        return ReturnCode::SUCCESS;
+    }
+
+protected:
+    // Both are only used by InitializationStrategy::InitializeFlow, which is overridden above.
+    bool HasTurbineProductionBeenCollected(vertexID /* turbineID */) override { return true; }
+
+    void UpdateFlowOnWalk(const std::vector<edgeID>& /* walk */, vertexID /* substationID */) override {
+        throw std::string("FlowFromFile does not route flow along walks.");
+    }
+
+private:
+    std::vector<int> flowOnOriginalEdges_;
+};
+
+} // namespace Algorithms
+
+} // namespace wcp
+
+#endif
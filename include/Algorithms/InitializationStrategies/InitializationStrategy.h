@@ -35,7 +35,7 @@ public:
       dijkstra_(std::move(dijkstra)),
       targetSubstation_(targetSubstation) {}
 
-    ReturnCode InitializeFlow() {
+    virtual ReturnCode InitializeFlow() {
         for (vertexID turbine : Windfarm().Turbines()) {
             if ( HasTurbineProductionBeenCollected(turbine) ) { continue; }
 
@@ -47,6 +47,11 @@ public:
             // substation and dijkstra_.ExtractWalk() yields a sequence of edges leading
             // from turbine to this substation. 
 
+            // The flow is incomplete, so there is no feasible solution to return.
+            if (returnCode == ReturnCode::TIME_LIMIT) {
+                return ReturnCode::TIME_LIMIT;
+            }
+
             // If no free substation was found, return now.
             if (returnCode == ReturnCode::INFEASIBLE) {
                 return ReturnCode::NO_FEASIBLE_SOLUTION_FOUND;
@@ -67,6 +72,10 @@ public:
         return ReturnCode::SUCCESS;
     }
 
+    void SetCancellationToken(Auxiliary::CancellationToken* cancellationToken) {
+        if (dijkstra_ != nullptr) { dijkstra_->SetCancellationToken(cancellationToken); }
+    }
+
     virtual ~InitializationStrategy() = default;
 
 protected:
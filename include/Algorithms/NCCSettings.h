@@ -0,0 +1,72 @@
+#ifndef ALGORITHMS_NCCSETTINGS
+#define ALGORITHMS_NCCSETTINGS
+
+#include <string>
+
+#include "IO/IncumbentStream.h"
+
+namespace wcp {
+
+namespace Algorithms {
+
+/**
+ * Optional settings of a negative cycle canceling run.
+ * The default values yield the algorithm as published.
+ */
+struct NCCSettings {
+    /**
+     * If positive, the detection first searches the neighborhood with this many hops
+     * around the most recently canceled cycles and only runs on the whole
+     * residual graph if no negative cycle is found there.
+     */
+    unsigned int localSearchHops = 0;
+
+    /**
+     * If larger than 1, NCC first sweeps over a grid of this many windows per axis
+     * (see SpatialWindows) and cancels cycles inside each window until no window
+     * improves. A global NCC run confirms the result afterwards.
+     */
+    unsigned int numberOfWindowsPerAxis = 1;
+
+    /**
+     * If true, NCC first solves the cluster of each substation as an independent
+     * subproblem in parallel (see RunDecomposedNCC) before the global NCC run.
+     */
+    bool decomposeBySubstations = false;
+
+    /**
+     * If positive, NCC first only cancels cycles whose costs are below -epsilon
+     * times their number of edges, starting with this epsilon and halving it
+     * (see RunEpsilonScaledNCC).
+     */
+    double initialEpsilon = 0;
+
+    /**
+     * If set, improvements of the best solution are passed to this stream during the run.
+     */
+    IO::IncumbentStream* incumbentStream = nullptr;
+
+    /**
+     * If not empty, EscapingNCC writes its state to this file between two iterations
+     * at most every checkpointIntervalInMilliseconds (see IO::CheckpointWriter).
+     */
+    std::string checkpointFile;
+    double checkpointIntervalInMilliseconds = 60000;
+
+    /**
+     * If not empty, EscapingNCC continues from the checkpoint in this file instead of computing an initial flow.
+     */
+    std::string resumeFile;
+
+    /**
+     * Number of threads for parallel subproblems; 0 uses one per hardware thread.
+     * Runs that are themselves one of several parallel runs use 1, see Builders::ParallelNCCRun.
+     */
+    unsigned int numberOfThreads = 0;
+};
+
+} // namespace Algorithms
+
+} // namespace wcp
+
+#endif
@@ -8,11 +8,16 @@
 #include <memory>
 #include <vector>
 
+#include "Algorithms/DeltaStrategies/CandidateDeltaFilter.h"
 #include "Algorithms/DeltaStrategies/DeltaStrategy.h"
+#include "Algorithms/DetectionStrategies/CycleFreeCertificates.h"
+#include "Algorithms/DetectionStrategies/HopNeighborhood.h"
 #include "Algorithms/DetectionStrategies/NegativeCycleDetection.h"
 #include "Algorithms/InitializationStrategies/InitializationStrategy.h"
 #include "Algorithms/ResidualCosts/StandardResidualCostComputer.h"
+#include "Algorithms/NCCSettings.h"
 
+#include "Auxiliary/CancellationToken.h"
 #include "Auxiliary/Constants.h"
 #include "Auxiliary/ReturnCodes.h"
 #include "Auxiliary/Timer.h"
@@ -43,7 +48,8 @@ public:
                             int /*seedInput*/,
                             bool beVerbose,
                             std::ostream& verboseStream = std::cout,
-                            double maxRunningTimeInMilliseconds = Auxiliary::DINFTY)
+                            double maxRunningTimeInMilliseconds = Auxiliary::DINFTY,
+                            const NCCSettings& settings = NCCSettings())
     : Timer(),
       beVerbose_(beVerbose),
       verboseStream_(verboseStream),
@@ -53,10 +59,24 @@ public:
       initializationStrategy_(std::move(initializationStrategy)),
       deltaStrategy_(std::move(deltaStrategy)),
       detectionStrategy_(std::move(detectionStrategy)),
+      candidateDeltaFilter_(windfarm.Cabletypes(), 2 * windfarm.Cabletypes().MaximumCapacity()),
+      cycleFreeCertificates_(windfarm, 2 * windfarm.Cabletypes().MaximumCapacity()),
+      lastDetectionCode_(ReturnCode::IN_PROGRESS),
+      settings_(settings),
+      minimumCostDecreasePerEdge_(0),
+      localNeighborhood_(windfarm),
       visitedVertex_(windfarm.NumberOfVertices()),
       logger_(logger),
       walkID_(0),
-      solutionCosts_(Auxiliary::DINFTY) {}
+      solutionCosts_(Auxiliary::DINFTY),
+      cancellationToken_(Timer, maxRunningTimeInMilliseconds)
+    {
+        // Single runs of detection and initialization can take long on large farms
+        detectionStrategy_->SetCancellationToken(&cancellationToken_);
+        if (initializationStrategy_) {
+            initializationStrategy_->SetCancellationToken(&cancellationToken_);
+        }
+    }
 
     Auxiliary::Timer Timer;
 
@@ -82,7 +102,20 @@ public:
                                                             bool isRegularNCCrun = true) {
         residualCostComputer.ComputeResidualCosts(delta);
         ReturnCode detectionCode = detectionStrategy_->Run();
+        lastDetectionCode_ = detectionCode;
+        return CancelDetectedNegativeCycle(logger, residualCostComputer, delta, isRegularNCCrun, detectionCode);
+    }
 
+protected:
+    /**
+     * Cancels a negative cycle found by the last detection run, which returned detectionCode.
+     */
+    template<typename LoggingClass, typename ResidualCostComputer>
+    ReturnCode CancelDetectedNegativeCycle( LoggingClass& logger,
+                                            ResidualCostComputer& residualCostComputer,
+                                            int delta,
+                                            bool isRegularNCCrun,
+                                            ReturnCode detectionCode) {
         if (IsTimeLimitExceeded()) {
             return ReturnCode::TIME_LIMIT;
         }
@@ -96,12 +129,30 @@ public:
 #endif
         }
 
+        if (hasANegativeCycleBeenCanceled && isRegularNCCrun) {
+            StreamIncumbent();
+        }
+
         return (hasANegativeCycleBeenCanceled) ? ReturnCode::SUCCESS : ReturnCode::NOTHING_CHANGED;
     }
 
-protected:
+    /**
+     * Variant of PerformNegativeCycleCancelingForSingleDelta for regular NCC runs
+     * with NCCSettings::localSearchHops > 0. The detection first runs on the
+     * neighborhood of the most recently canceled cycles and only on the whole
+     * residual graph if no negative cycle is canceled there.
+     */
+    ReturnCode PerformLocalThenGlobalNegativeCycleCanceling(int changeOfFlow);
+
+    /**
+     * Replaces the region for local detection by the neighborhood of
+     * the vertices on cycles canceled since the last call. The region is
+     * empty, i.e., there is no local run, if no cycle has been canceled.
+     */
+    void UpdateLocalDetectionRegion();
+
     bool IsTimeLimitExceeded() { return IsTimeLimitExceeded(Timer.ElapsedMilliseconds()); }
-    bool IsTimeLimitExceeded(double elapsedMilliseconds) { return elapsedMilliseconds > maxRunningTimeInMilliseconds_; }
+    bool IsTimeLimitExceeded(double elapsedMilliseconds) { return elapsedMilliseconds > maxRunningTimeInMilliseconds_ || cancellationToken_.IsCancelled(); }
 
     virtual void dealWithBonbons(bool canceledAnyCycle, edgeID duplicateVertex, int changeOfFlow) {
         (void) canceledAnyCycle;
@@ -111,10 +162,91 @@ protected:
 
     virtual void doSpecificReporting() {};
 
+    /**
+     * The best solution known so far, which is passed to NCCSettings::incumbentStream.
+     * By default, this is the current flow.
+     */
+    virtual double IncumbentCost() { return solutionCosts_; }
+    virtual int IncumbentFlowOnEdge(edgeID edge) { return windfarm_.FlowOnEdge(edge); }
+
+    /**
+     * Passes the incumbent to NCCSettings::incumbentStream if one is set and an update is due.
+     * A forced update ignores the minimum interval between updates.
+     */
+    void StreamIncumbent(bool force = false) {
+        if (settings_.incumbentStream == nullptr) { return; }
+        double cost = IncumbentCost();
+        if (!settings_.incumbentStream->IsDue(cost, force)) { return; }
+        settings_.incumbentStream->Emit(cost, windfarm_.NumberOfOriginalEdges(), [this](edgeID edge) { return IncumbentFlowOnEdge(edge); });
+    }
+
     ReturnCode ComputeInitialFlow();
 
     ReturnCode RunNCCforAllDeltas();
 
+    /**
+     * Runs the delta strategy until no delta yields a cycle that is canceled.
+     * Returns ReturnCode::TIME_LIMIT if the time limit is exceeded and ReturnCode::SUCCESS, otherwise.
+     */
+    ReturnCode CancelNegativeCyclesForAllDeltas();
+
+    /**
+     * Runs CancelNegativeCyclesForAllDeltas for a geometrically decreasing epsilon,
+     * starting from NCCSettings::initialEpsilon, in which only cycles with costs
+     * below -epsilon times their number of edges are canceled. Large improvements
+     * are thus made first. Stops once epsilon is below the rounding precision
+     * or after MAXIMUM_NUMBER_OF_EPSILON_PHASES phases, whichever comes first.
+     */
+    ReturnCode RunEpsilonScaledNCC();
+
+    /**
+     * Bounds the number of phases of RunEpsilonScaledNCC, such that the last
+     * epsilon is at least initialEpsilon / 2^15 regardless of its magnitude.
+     */
+    static const unsigned int MAXIMUM_NUMBER_OF_EPSILON_PHASES = 16;
+
+    /**
+     * Sweeps over the windows of NCCSettings::numberOfWindowsPerAxis until
+     * no window improves. Returns ReturnCode::TIME_LIMIT if the time limit is
+     * exceeded, ReturnCode::SUCCESS if any cycle has been canceled and
+     * ReturnCode::NOTHING_CHANGED, otherwise.
+     */
+    ReturnCode RunWindowedNCC();
+
+    /**
+     * Cancels negative cycles within the subgraph induced by window for all deltas.
+     * Edges leaving the window keep their flow.
+     */
+    ReturnCode RunNCCforAllDeltasOnWindow(const std::vector<vertexID>& window);
+
+    /**
+     * Splits the vertices into the clusters of SubstationClusters and cancels
+     * negative cycles within each cluster in parallel on a copy of the windfarm.
+     * The flow into each substation stays fixed. Afterwards, the flows of the
+     * clusters are merged into windfarm_. Returns ReturnCode::TIME_LIMIT if the
+     * time limit is exceeded, ReturnCode::SUCCESS if the costs decreased and
+     * ReturnCode::NOTHING_CHANGED, otherwise.
+     */
+    ReturnCode RunDecomposedNCC();
+
+    /**
+     * Returns false if no edge can have negative residual costs for changeOfFlow,
+     * so that a detection run cannot find a negative cycle.
+     */
+    bool CanDeltaYieldNegativeCycle(int changeOfFlow) {
+        return ResidualCostComputer().HasAdaptedResidualCosts()
+                || candidateDeltaFilter_.CanYieldNegativeCycle(changeOfFlow, windfarm_);
+    }
+
+    /**
+     * Returns whether an earlier detection run for changeOfFlow has proven that there is
+     * no negative cycle and the flow has not changed in a way that could create one.
+     */
+    bool IsKnownToBeCycleFree(int changeOfFlow) {
+        return !ResidualCostComputer().HasAdaptedResidualCosts()
+                && cycleFreeCertificates_.IsValid(changeOfFlow);
+    }
+
     int MaximumFlowChange() const {
         return 2 * windfarm_.Cabletypes().MaximumCapacity();
     }
@@ -130,15 +262,15 @@ protected:
         bool hasANegativeCycleBeenCanceled = false;
         while (!hasANegativeCycleBeenCanceled) {
             // ExtractNegativeClosedWalk for BF returns an empty walk if no edge can be relaxed further after n-1 iterations.
-            auto negativeWalk = detectionStrategy_->ExtractNegativeClosedWalk();
-            if (negativeWalk.empty()) {
+            detectionStrategy_->ExtractNegativeClosedWalk(negativeWalk_);
+            if (negativeWalk_.empty()) {
                 return false;
             }
 
             if (IsTimeLimitExceeded()) { return false; }
 
             // A negative closed walk has been found.
-            hasANegativeCycleBeenCanceled = CancelNegativeWalk(logger, residualCostComputer, negativeWalk, changeOfFlow, isRegularNCCrun);
+            hasANegativeCycleBeenCanceled = CancelNegativeWalk(logger, residualCostComputer, negativeWalk_, changeOfFlow, isRegularNCCrun);
             // If no cycle has been canceled, find another walk. Otherwise, residual costs may not be valid anymore.
         }
         return hasANegativeCycleBeenCanceled;
@@ -157,6 +289,7 @@ protected:
         edgeID edgeOnWalk = walk.front(); // Needed for dealing with bonbons. We need to put it here, since walk will be emptied if there is a bonbon.
 
         bool canceledAnyCycle = false; // Will be set true once a cycle is canceled
+        bool rejectedAnyCycleForEpsilon = false; // Will be set true once a negative cycle is only rejected due to epsilon
 
         size_t currentIndex = 0;
         vertexID duplicateVertex = INVALID_VERTEX;
@@ -173,7 +306,7 @@ protected:
                 return windfarm_.StartVertex(edge) == duplicateVertex;
             });
 
-            canceledAnyCycle |= CancelCycle(logger, residualCostComputer, cycleBegin, cycleEnd, changeOfFlow);
+            canceledAnyCycle |= CancelCycle(logger, residualCostComputer, cycleBegin, cycleEnd, changeOfFlow, rejectedAnyCycleForEpsilon);
 
             // Set up currentIndex for next iteration. currentIndex is on first edge after simple cycle
             currentIndex = std::distance(walk.begin(), cycleBegin);
@@ -188,7 +321,10 @@ protected:
         // Do whatever is necessary in terms of tracking bonbons. Note that the initial assert(!walk.empty())
         // makes sure that there was indeed a negative walk in the variable walk. If at this point canceledAnyCycle
         // is false, then the walk was an unhelpful bonbon and we might want to record it for potential escaping.
-        dealWithBonbons(canceledAnyCycle, edgeOnWalk, changeOfFlow);
+        // A walk whose negative cycles were only rejected due to epsilon is no bonbon, so it is not recorded.
+        if (canceledAnyCycle || !rejectedAnyCycleForEpsilon) {
+            dealWithBonbons(canceledAnyCycle, edgeOnWalk, changeOfFlow);
+        }
 
         if (isRegularNCCrun) { ++walkID_; }
 
@@ -198,14 +334,18 @@ protected:
     using WalkIterator = std::vector<edgeID>::iterator;
 
     /**
-     * Cancel the cycle given by the two iterators if the cycle has length at least 3 and negative costs.
+     * Cancel the cycle given by the two iterators if the cycle has length at least 3 and negative costs,
+     * even if its residual costs are rounded (see RoundingErrorOfWalk). Sets rejectedForEpsilon if such a cycle is not canceled only because its costs are not below
+     * -minimumCostDecreasePerEdge_ times its length.
      */
     template<typename LoggingClass, typename ResidualCostComputer>
-    bool CancelCycle(LoggingClass& logger, ResidualCostComputer& residualCostComputer, WalkIterator begin, WalkIterator end, int changeOfFlow) {
+    bool CancelCycle(LoggingClass& logger, ResidualCostComputer& residualCostComputer, WalkIterator begin, WalkIterator end, int changeOfFlow, bool& rejectedForEpsilon) {
         size_t length = std::distance(begin, end);
         double costChange = CostOfWalk(begin, end);
+        double costChangeUpperBound = costChange + RoundingErrorOfWalk(begin, end);
 
-        bool cycleWillBeCanceled = length > 2 && costChange < 0;
+        bool cycleWillBeCanceled = length > 2 && costChangeUpperBound < -minimumCostDecreasePerEdge_ * length;
+        if (!cycleWillBeCanceled && length > 2 && costChangeUpperBound < 0) { rejectedForEpsilon = true; }
         logger.CycleHasBeenFound("NCC", changeOfFlow, walkID_, costChange,
                                     length, Timer.ElapsedMilliseconds(),
                                     solutionCosts_, cycleWillBeCanceled);
@@ -215,12 +355,13 @@ protected:
             for (WalkIterator it = begin; it != end; ++it) {
                 residualCostComputer.CreateNewCableTypeWhileCanceling(*it, changeOfFlow, false, verboseStream_); // not needed for standard NCC runs, only during escaping.
                 windfarm_.AddFlowOnEdge(*it, changeOfFlow);
+                if (settings_.localSearchHops > 0) { verticesOnCanceledCycles_.push_back(windfarm_.StartVertex(*it)); }
             }
 
             if (beVerbose_) {
                 verboseStream_ << "\t\tCancel negative cycle:";
                 for (WalkIterator it = begin; it != end; ++it) {
-                        verboseStream_ << " " <<*it;
+                        verboseStream_ << " " << EdgeIndexForOutput(*it);
                     }
                 verboseStream_ << ".\n";
             }
@@ -231,6 +372,21 @@ protected:
 
     double CostOfWalk(WalkIterator begin, WalkIterator end);
 
+    /**
+     * Bounds the difference between CostOfWalk and the sum of the unrounded residual costs.
+     * It is 0 unless built with WCP_COMPACT, in which residual costs are stored as float.
+     * Otherwise, a cycle that is only negative due to rounding could increase the costs.
+     */
+    double RoundingErrorOfWalk(WalkIterator begin, WalkIterator end);
+
+    /**
+     * Returns the index of an edge for verbose output in the numbering of the input file,
+     * see DataStructures::Instance::Renumber(). The reverse edge of an original edge keeps
+     * its offset of NumberOfOriginalEdges(). Supersubstation edges and all edges of an edited
+     * wind farm keep their internal index.
+     */
+    edgeID EdgeIndexForOutput(edgeID edge) const;
+
     bool IsEndVertexVisited(edgeID edge) const {
         vertexID endVertex = windfarm_.EndVertex(edge);
         return visitedVertex_[endVertex];
@@ -257,11 +413,51 @@ protected:
     std::unique_ptr<Algorithms::DeltaStrategy> deltaStrategy_;
     std::unique_ptr<Algorithms::NegativeCycleDetection> detectionStrategy_;
 
+    CandidateDeltaFilter candidateDeltaFilter_;
+
+    /**
+     * Certificates are only issued and checked for standard residual costs.
+     */
+    CycleFreeCertificates cycleFreeCertificates_;
+
+    /**
+     * The return code of the last detection run. ReturnCode::EARLY_TERMINATION
+     * means that the residual graph contains no negative closed walk.
+     */
+    ReturnCode lastDetectionCode_;
+
+    NCCSettings settings_;
+
+    /**
+     * Only cycles with costs below -minimumCostDecreasePerEdge_ times their length are canceled.
+     * It is positive only during RunEpsilonScaledNCC.
+     */
+    double minimumCostDecreasePerEdge_;
+
+    /**
+     * Local detection runs on localDetectionRegion_, which is the neighborhood of
+     * the vertices on the cycles that were canceled most recently.
+     */
+    HopNeighborhood localNeighborhood_;
+    std::vector<vertexID> verticesOnCanceledCycles_;
+    std::vector<vertexID> localDetectionRegion_;
+
     std::vector<bool> visitedVertex_;
 
+    /**
+     * The walk currently being canceled. Its memory is reused by every extraction.
+     */
+    std::vector<edgeID> negativeWalk_;
+
     IO::NCCLogger& logger_;
     int walkID_;
     double solutionCosts_;
+
+    /**
+     * Cancelled at the time limit or by a signal. It is also checked inside single
+     * detection and initialization runs, which then return ReturnCode::TIME_LIMIT.
+     */
+    Auxiliary::CancellationToken cancellationToken_;
 };
 
 } // namespace Algorithms
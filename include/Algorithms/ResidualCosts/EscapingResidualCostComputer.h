@@ -46,6 +46,14 @@ public:
         desiredResidualCosts_.WriteToStream(os);
     }
 
+    const SpecialResidualCostCollection& AdaptedResidualCosts() const {
+        return desiredResidualCosts_;
+    }
+
+    bool HasAdaptedResidualCosts() const {
+        return !desiredResidualCosts_.isEmpty();
+    }
+
 protected:
     // Maintains all edges with non-standard residual costs.
     SpecialResidualCostCollection desiredResidualCosts_;
@@ -53,10 +61,10 @@ protected:
     void ApplyContentOfSpecialResidualCostCollection(int changeOfFlow) {
         for (auto&& desiredCostTuple : desiredResidualCosts_.showVector()) {
             edgeID currentEdge = desiredCostTuple.edgeWithSpecialCosts;
-            windfarm_.ResidualCostOnEdge(currentEdge) = ResidualCostForNonSupersubstationEdge(  currentEdge,
+            windfarm_.SetResidualCostOnEdge(currentEdge, ResidualCostForNonSupersubstationEdge(  currentEdge,
                                                                                                 windfarm_.StartVertex(currentEdge),
                                                                                                 changeOfFlow,
-                                                                                                desiredCostTuple.cables);
+                                                                                                desiredCostTuple.cables));
         }
     }
 
@@ -40,7 +40,7 @@ public:
             // An edge is called saturated if sending changeOfFlow additional units along it is feasible, but requires a bigger cable type.
             // We want to give those bigger cable types away for free.
             if (windfarm_.FlowOnEdge(id) != 0 && windfarm_.ResidualCostOnEdge(id) > 0 && windfarm_.ResidualCostOnEdge(id) < Auxiliary::DINFTY) {
-                windfarm_.ResidualCostOnEdge(id) = 0;
+                windfarm_.SetResidualCostOnEdge(id, 0);
                 isSaturatedEdge[id] = true;
             } else {
                 isSaturatedEdge[id] = false;
@@ -48,6 +48,8 @@ public:
         }
     }
 
+    bool HasAdaptedResidualCosts() const { return true; }
+
     void CreateNewCableTypeWhileCanceling(edgeID edge, int changeOfFlow, bool beVerbose_, std::ostream& verboseStream_) {
         assert(edge >= 0);
         assert(edge < windfarm_.NumberOfEdges());
@@ -3,6 +3,7 @@
 
 #include <cassert>
 #include <iostream>
+#include <vector>
 
 #include "Algorithms/ResidualCosts/SpecializedResidualCosts.h"
 
@@ -45,16 +46,59 @@ public:
 
     virtual void CreateNewCableTypeWhileCanceling(edgeID /*edge*/, int /*changeOfFlow*/, bool /*beVerbose_*/, std::ostream& /*verboseStream_*/) {}
 
+    /**
+     * Returns whether some residual costs deviate from the standard definition.
+     * In that case, reasoning based on the cable types alone does not apply.
+     */
+    virtual bool HasAdaptedResidualCosts() const { return false; }
+
+    /**
+     * Computes standard residual costs only for the outgoing edges of regionVertices.
+     */
+    void ComputeStandardResidualCostsOnRegion(int changeOfFlow, const std::vector<vertexID>& regionVertices) {
+        for (vertexID vertex : regionVertices) {
+            for (edgeID edge : windfarm_.OutgoingEdges(vertex)) {
+                windfarm_.SetResidualCostOnEdge(edge, ResidualCosts(edge, changeOfFlow));
+            }
+        }
+    }
+
+    /**
+     * Returns the standard residual cost of edge for changeOfFlow
+     * under the assumption that the flow on edge is flowOnEdge.
+     */
+    double ResidualCostForFlow(edgeID edge, int flowOnEdge, int changeOfFlow) const {
+        vertexID start = windfarm_.StartVertex(edge);
+        vertexID end = windfarm_.EndVertex(edge);
+        // First two ifs: Is edge an edge to or from a super substation?
+        if (windfarm_.IsSuperSubstation(start)) {
+            assert(windfarm_.IsSubstation(end));
+            int flowToSubstation = -flowOnEdge;
+            return (changeOfFlow <= flowToSubstation) ? 0 : Auxiliary::DINFTY;
+        }
+        if (windfarm_.IsSuperSubstation(end)) {
+            assert(windfarm_.IsSubstation(start));
+            int freeCapacity = windfarm_.VertexCapacity(start) - flowOnEdge;
+            return (changeOfFlow <= freeCapacity) ? 0 : Auxiliary::DINFTY;
+        }
+
+        return ResidualCostForNonSupersubstationEdge(edge, start, flowOnEdge, changeOfFlow, windfarm_.Cabletypes());
+    }
+
 protected:
     void ComputeStandardResidualCosts(int changeOfFlow) {
         for (edgeID edge = 0; edge < windfarm_.NumberOfEdges(); ++edge) {
-            windfarm_.ResidualCostOnEdge(edge) = ResidualCosts(edge, changeOfFlow);
+            windfarm_.SetResidualCostOnEdge(edge, ResidualCosts(edge, changeOfFlow));
         }
     }
     
     DataStructures::WindfarmResidual& windfarm_;
 
     double ResidualCostForNonSupersubstationEdge(edgeID edge, vertexID start, int changeOfFlow, const DataStructures::Cabletypes& cabletypes) const {
+        return ResidualCostForNonSupersubstationEdge(edge, start, windfarm_.FlowOnEdge(edge), changeOfFlow, cabletypes);
+    }
+
+    double ResidualCostForNonSupersubstationEdge(edgeID edge, vertexID start, int flow, int changeOfFlow, const DataStructures::Cabletypes& cabletypes) const {
         assert(windfarm_.StartVertex(edge) == start);
         assert(!windfarm_.IsSuperSubstation(start));
         assert(!windfarm_.IsSuperSubstation(windfarm_.EndVertex(edge)));
@@ -63,14 +107,13 @@ protected:
         if (windfarm_.IsSubstation(start)) {
             // edge goes from a substation to a turbine
             // At most the flow to start can be redirected
-            remainingCapacity = -windfarm_.FlowOnEdge(edge);
+            remainingCapacity = -flow;
         } else {
             // edge starts at a turbine (goes to turbine or substation)
-            remainingCapacity = windfarm_.FreeEdgeCapacity(edge);
+            remainingCapacity = windfarm_.Cabletypes().MaximumCapacity() - flow;
         }
         // Compare delta with free capacity to determine costs
         if (changeOfFlow <= remainingCapacity) {
-            int flow = windfarm_.FlowOnEdge(edge);
             return (cabletypes.CostOfFlow(flow + changeOfFlow) - cabletypes.CostOfFlow(flow))
                     * windfarm_.Length(edge);
         } else {
@@ -81,26 +124,8 @@ protected:
 
 private:
     double ResidualCosts(edgeID edge, int changeOfFlow) const {
-        vertexID start = windfarm_.StartVertex(edge);
-        vertexID end = windfarm_.EndVertex(edge);
-        // First two ifs: Is edge an edge to or from a super substation?
-        if (windfarm_.IsSuperSubstation(start)) {
-            assert(windfarm_.IsSubstation(end));
-            int flowToSubstation = -windfarm_.FlowOnEdge(edge);
-            assert(flowToSubstation >= 0);
-            return (changeOfFlow <= flowToSubstation) ? 0 : Auxiliary::DINFTY;
-        }
-        if (windfarm_.IsSuperSubstation(end)) {
-            assert(windfarm_.IsSubstation(start));
-            int freeCapacity = windfarm_.FreeSubstationCapacity(start);
-            return (changeOfFlow <= freeCapacity) ? 0 : Auxiliary::DINFTY;
-        }
-
-        return ResidualCostForNonSupersubstationEdge(edge, start, changeOfFlow);
-    }
-
-    double ResidualCostForNonSupersubstationEdge(edgeID edge, vertexID start, int changeOfFlow) const {
-        return ResidualCostForNonSupersubstationEdge(edge, start, changeOfFlow, windfarm_.Cabletypes());
+        assert(!windfarm_.IsSuperSubstation(windfarm_.StartVertex(edge)) || windfarm_.FlowOnEdge(edge) <= 0);
+        return ResidualCostForFlow(edge, windfarm_.FlowOnEdge(edge), changeOfFlow);
     }
 };
 
@@ -0,0 +1,81 @@
+#ifndef ALGORITHMS_SHAREDINCUMBENT
+#define ALGORITHMS_SHAREDINCUMBENT
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "Auxiliary/Constants.h"
+
+namespace wcp {
+
+namespace Algorithms {
+
+/**
+ * An immutable copy of the best flow known to any chain.
+ */
+struct IncumbentSnapshot {
+    double cost;
+    std::vector<int> flow;
+};
+
+/**
+ * The best solution shared between several EscapingNCC chains running in parallel.
+ *
+ * Snapshots are never modified after publication. A new best solution is published
+ * by atomically swapping the pointer. The atomic operations on std::shared_ptr may
+ * take a lock inside the standard library, so the best cost is also kept in an
+ * atomic double. Offers and readers check it first and only touch the pointer if
+ * the cost improves. It may lag behind the snapshot for a moment, but never
+ * undercuts it.
+ */
+class SharedIncumbent {
+public:
+    SharedIncumbent()
+      : bestCost_(Auxiliary::INFINITE_COST),
+        snapshot_(std::make_shared<const IncumbentSnapshot>(IncumbentSnapshot{Auxiliary::INFINITE_COST, std::vector<int>()})) {}
+
+    SharedIncumbent(const SharedIncumbent&) = delete;
+    void operator=(const SharedIncumbent&) = delete;
+
+    /**
+     * Publishes flow if its cost is strictly smaller than the cost of the current incumbent.
+     * Returns true if flow has become the new incumbent.
+     */
+    bool Offer(double cost, const std::vector<int>& flow) {
+        if (!(cost < BestCost())) { return false; }
+
+        std::shared_ptr<const IncumbentSnapshot> current = std::atomic_load(&snapshot_);
+        std::shared_ptr<const IncumbentSnapshot> candidate = std::make_shared<const IncumbentSnapshot>(IncumbentSnapshot{cost, flow});
+        while (cost < current->cost) {
+            // On failure, current is updated to the snapshot another chain has published in the meantime
+            if (std::atomic_compare_exchange_weak(&snapshot_, &current, candidate)) {
+                LowerBestCost(cost);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    std::shared_ptr<const IncumbentSnapshot> Load() const { return std::atomic_load(&snapshot_); }
+
+    /**
+     * Returns the cost of the incumbent without touching the snapshot.
+     */
+    double BestCost() const { return bestCost_.load(std::memory_order_acquire); }
+
+private:
+    void LowerBestCost(double cost) {
+        double best = bestCost_.load(std::memory_order_relaxed);
+        while (cost < best && !bestCost_.compare_exchange_weak(best, cost, std::memory_order_release, std::memory_order_relaxed)) {}
+    }
+
+    std::atomic<double> bestCost_;
+    std::shared_ptr<const IncumbentSnapshot> snapshot_;
+};
+
+} // namespace Algorithms
+
+} // namespace wcp
+
+#endif
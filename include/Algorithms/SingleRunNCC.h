@@ -10,6 +10,7 @@
 #include "Algorithms/InitializationStrategies/InitializationStrategy.h"
 #include "Algorithms/ResidualCosts/StandardResidualCostComputer.h"
 #include "Algorithms/NegativeCycleCanceling.h"
+#include "Algorithms/NCCSettings.h"
 
 #include "Auxiliary/ReturnCodes.h"
 
@@ -38,7 +39,8 @@ public:
                   int seedInput,
                   bool beVerbose,
                   std::ostream& verboseStream = std::cout,
-                  double maxRunningTimeInMilliseconds = Auxiliary::DINFTY)
+                  double maxRunningTimeInMilliseconds = Auxiliary::DINFTY,
+                  const NCCSettings& settings = NCCSettings())
       : NegativeCycleCanceling( instance,
                                 windfarm,
                                 logger,
@@ -48,7 +50,8 @@ public:
                                 seedInput,
                                 beVerbose,
                                 verboseStream,
-                                maxRunningTimeInMilliseconds),
+                                maxRunningTimeInMilliseconds,
+                                settings),
         residualCostComputer_(windfarm)
     {
         RunCompleteAlgorithm();
@@ -62,7 +65,9 @@ private:
     ReturnCode RunCompleteAlgorithm() {
         ReturnCode stateOfAlgorithm = ComputeInitialFlow();
         if (stateOfAlgorithm == ReturnCode::SUCCESS) {
+            StreamIncumbent(true);
             stateOfAlgorithm = RunNCCforAllDeltas();
+            StreamIncumbent(true);
         }
         return stateOfAlgorithm;
     }
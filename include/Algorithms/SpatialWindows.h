@@ -0,0 +1,86 @@
+#ifndef ALGORITHMS_SPATIALWINDOWS
+#define ALGORITHMS_SPATIALWINDOWS
+
+#include <algorithm>
+#include <vector>
+
+#include "Auxiliary/Constants.h"
+
+#include "DataStructures/Graphs/WindfarmResidual.h"
+
+namespace wcp {
+
+namespace Algorithms {
+
+/**
+ * Tiles a windfarm into a grid of overlapping windows based on the vertex coordinates.
+ *
+ * The bounding box of all turbines and substations is split into
+ * numberOfWindowsPerAxis x numberOfWindowsPerAxis cells. Each window consists of
+ * the vertices in one cell enlarged by OVERLAP times the cell size on each side,
+ * so that cycles across cell borders are inside some window. A window that
+ * contains a substation also contains the supersubstation.
+ */
+class SpatialWindows {
+public:
+    SpatialWindows(const DataStructures::WindfarmResidual& windfarm, unsigned int numberOfWindowsPerAxis) {
+        if (numberOfWindowsPerAxis == 0) { return; }
+
+        double minX = Auxiliary::DINFTY, maxX = -Auxiliary::DINFTY;
+        double minY = Auxiliary::DINFTY, maxY = -Auxiliary::DINFTY;
+        for (vertexID vertex = 0; vertex < windfarm.NumberOfVertices(); ++vertex) {
+            if (windfarm.IsSuperSubstation(vertex)) continue;
+            minX = std::min(minX, windfarm.X(vertex));
+            maxX = std::max(maxX, windfarm.X(vertex));
+            minY = std::min(minY, windfarm.Y(vertex));
+            maxY = std::max(maxY, windfarm.Y(vertex));
+        }
+        double cellWidth = (maxX - minX) / numberOfWindowsPerAxis;
+        double cellHeight = (maxY - minY) / numberOfWindowsPerAxis;
+
+        for (unsigned int i = 0; i < numberOfWindowsPerAxis; ++i) {
+            for (unsigned int j = 0; j < numberOfWindowsPerAxis; ++j) {
+                double left = minX + (i - OVERLAP) * cellWidth;
+                double right = minX + (i + 1 + OVERLAP) * cellWidth;
+                double bottom = minY + (j - OVERLAP) * cellHeight;
+                double top = minY + (j + 1 + OVERLAP) * cellHeight;
+
+                std::vector<vertexID> window;
+                bool containsSubstation = false;
+                for (vertexID vertex = 0; vertex < windfarm.NumberOfVertices(); ++vertex) {
+                    if (windfarm.IsSuperSubstation(vertex)) continue;
+                    double x = windfarm.X(vertex);
+                    double y = windfarm.Y(vertex);
+                    if (left <= x && x <= right && bottom <= y && y <= top) {
+                        window.push_back(vertex);
+                        containsSubstation |= windfarm.IsSubstation(vertex);
+                    }
+                }
+                if (containsSubstation) {
+                    // The supersubstation is the last vertex, so window stays sorted
+                    window.push_back(windfarm.SuperSubstationIdentifier());
+                }
+                // A window needs at least three vertices for a cycle
+                if (window.size() > 2) {
+                    windows_.push_back(std::move(window));
+                }
+            }
+        }
+    }
+
+    /**
+     * The vertices of each window in increasing order.
+     */
+    const std::vector<std::vector<vertexID>>& Windows() const { return windows_; }
+
+private:
+    std::vector<std::vector<vertexID>> windows_;
+
+    static constexpr double OVERLAP = 0.25;
+};
+
+} // namespace Algorithms
+
+} // namespace wcp
+
+#endif
@@ -0,0 +1,68 @@
+#ifndef ALGORITHMS_SUBSTATIONCLUSTERS
+#define ALGORITHMS_SUBSTATIONCLUSTERS
+
+#include <algorithm>
+#include <queue>
+#include <vector>
+
+#include "DataStructures/Graphs/WindfarmResidual.h"
+
+namespace wcp {
+
+namespace Algorithms {
+
+/**
+ * Splits the vertices of a windfarm into one cluster per substation based on the current flow.
+ *
+ * As in EscapingLeaves::IdentifyTurbineSubstationAssignmentUsingBFS, a breadth-first
+ * search from each substation follows the edges with flow. Unlike there, each turbine
+ * is only assigned to the first substation that reaches it, so the clusters are disjoint.
+ * The supersubstation is in no cluster, hence cycles within a cluster do not change
+ * the flow into its substation.
+ */
+class SubstationClusters {
+public:
+    SubstationClusters(const DataStructures::WindfarmResidual& windfarm) {
+        std::vector<bool> isAssigned(windfarm.NumberOfVertices(), false);
+
+        for (vertexID substation : windfarm.Substations()) {
+            std::vector<vertexID> cluster;
+            std::queue<vertexID> accessibleVertices;
+            accessibleVertices.push(substation);
+            isAssigned[substation] = true;
+
+            while (!accessibleVertices.empty()) {
+                vertexID currentVertex = accessibleVertices.front();
+                accessibleVertices.pop();
+                cluster.push_back(currentVertex);
+
+                for (edgeID edge : windfarm.OutgoingEdges(currentVertex)) {
+                    vertexID endVertex = windfarm.EndVertex(edge);
+                    if (windfarm.FlowOnEdge(edge) == 0 || isAssigned[endVertex] || !windfarm.IsTurbine(endVertex)) continue;
+                    isAssigned[endVertex] = true;
+                    accessibleVertices.push(endVertex);
+                }
+            }
+
+            // A cluster needs at least three vertices for a cycle
+            if (cluster.size() > 2) {
+                std::sort(cluster.begin(), cluster.end());
+                clusters_.push_back(std::move(cluster));
+            }
+        }
+    }
+
+    /**
+     * The vertices of each cluster in increasing order.
+     */
+    const std::vector<std::vector<vertexID>>& Clusters() const { return clusters_; }
+
+private:
+    std::vector<std::vector<vertexID>> clusters_;
+};
+
+} // namespace Algorithms
+
+} // namespace wcp
+
+#endif
@@ -0,0 +1,83 @@
+#ifndef ALGORITHMS_TOPOLOGYEDITOR
+#define ALGORITHMS_TOPOLOGYEDITOR
+
+#include <memory>
+
+#include "Algorithms/Distance/Dijkstra.h"
+#include "Algorithms/Distance/EuclideanLength.h"
+
+#include "DataStructures/Graphs/WindfarmResidual.h"
+
+namespace wcp {
+
+namespace Algorithms {
+
+/**
+ * Applies small edits of the topology to a wind farm with a feasible flow and
+ * repairs feasibility locally. Only the units of flow that an edit invalidates
+ * are rerouted, each along a shortest path with free capacity to the closest
+ * substation with free capacity. Afterwards, NCC can continue from the repaired
+ * flow (see Builders::NCCControler::Reoptimize), which is much cheaper than
+ * reading the changed instance and initializing from scratch.
+ *
+ * All edits throw a string if their input is invalid or if no feasible flow
+ * can be found. In the latter case, the flow is left infeasible.
+ */
+class TopologyEditor {
+public:
+    TopologyEditor(WindfarmResidual& windfarm)
+      : windfarm_(windfarm),
+        dijkstra_(windfarm, std::make_unique<EuclideanLength>()),
+        numberOfReroutedUnits_(0) {}
+
+    /**
+     * Moves a turbine or substation. The flow stays feasible; only the lengths of its edges change.
+     */
+    void MoveVertex(vertexID vertex, double x, double y);
+
+    /**
+     * Changes the capacity of a substation. If it receives more flow than the new capacity,
+     * the excess units are rerouted to other substations.
+     */
+    void SetSubstationCapacity(vertexID substation, int capacity);
+
+    /**
+     * Adds a candidate cable without flow and returns its edge index.
+     */
+    edgeID AddEdge(vertexID source, vertexID target);
+
+    /**
+     * Removes an original edge and reroutes the flow on it. The last original edge takes over its index.
+     */
+    void RemoveEdge(edgeID edge);
+
+    /**
+     * Returns the number of units of flow that have been rerouted by all edits so far.
+     */
+    int NumberOfReroutedUnits() const { return numberOfReroutedUnits_; }
+
+private:
+    /**
+     * Removes one unit of flow from vertex to a substation along edges with positive flow.
+     * The unit that arrived at vertex is then missing, i.e., this has to be paired with
+     * decreasing the flow into vertex.
+     */
+    void ReleaseUnitTowardsSubstation(vertexID vertex);
+
+    /**
+     * Sends one unit of flow from vertex to the closest substation with free capacity.
+     */
+    void RerouteUnitFrom(vertexID vertex);
+
+    void CheckVertex(vertexID vertex) const;
+
+    WindfarmResidual& windfarm_;
+    Dijkstra dijkstra_;
+    int numberOfReroutedUnits_;
+};
+
+} // namespace Algorithms
+
+} // namespace wcp
+
+#endif
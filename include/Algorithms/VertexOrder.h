@@ -0,0 +1,140 @@
+#ifndef ALGORITHMS_VERTEXORDER
+#define ALGORITHMS_VERTEXORDER
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "DataStructures/Instance.h"
+
+namespace wcp {
+
+namespace Algorithms {
+
+/**
+ * Orders of the vertices of an instance for DataStructures::Instance::Renumber(),
+ * so that vertices that are close in the plane or in the graph get close indices.
+ * Each function returns the new index of every vertex.
+ */
+
+/**
+ * Returns the position of the cell (x, y) of a 2^16 x 2^16 grid along the Hilbert curve.
+ */
+inline std::uint64_t HilbertIndex(std::uint32_t x, std::uint32_t y) {
+    const std::uint32_t n = 1u << 16;
+    std::uint64_t index = 0;
+    for (std::uint32_t s = n / 2; s > 0; s /= 2) {
+        std::uint32_t rx = (x & s) > 0;
+        std::uint32_t ry = (y & s) > 0;
+        index += static_cast<std::uint64_t>(s) * s * ((3 * rx) ^ ry);
+        // Rotate the quadrant so that the curve is continuous
+        if (ry == 0) {
+            if (rx == 1) {
+                x = n - 1 - x;
+                y = n - 1 - y;
+            }
+            std::swap(x, y);
+        }
+    }
+    return index;
+}
+
+/**
+ * Orders the vertices along a Hilbert curve through the bounding box of their coordinates.
+ */
+inline std::vector<int> HilbertOrder(const DataStructures::Instance& instance) {
+    const std::vector<DataStructures::InstanceVertex>& vertices = instance.Vertices();
+    double minX = vertices.front().x, maxX = vertices.front().x;
+    double minY = vertices.front().y, maxY = vertices.front().y;
+    for (const DataStructures::InstanceVertex& vertex : vertices) {
+        minX = std::min(minX, vertex.x); maxX = std::max(maxX, vertex.x);
+        minY = std::min(minY, vertex.y); maxY = std::max(maxY, vertex.y);
+    }
+    // The same scale in both directions keeps distances comparable
+    const double extent = std::max(maxX - minX, maxY - minY);
+    const double scale = extent > 0 ? ((1 << 16) - 1) / extent : 0;
+
+    std::vector<std::pair<std::uint64_t, int>> keys;
+    keys.reserve(vertices.size());
+    for (std::size_t vertex = 0; vertex < vertices.size(); ++vertex) {
+        keys.emplace_back(HilbertIndex(static_cast<std::uint32_t>((vertices[vertex].x - minX) * scale),
+                                       static_cast<std::uint32_t>((vertices[vertex].y - minY) * scale)),
+                          vertex);
+    }
+    std::sort(keys.begin(), keys.end());
+
+    std::vector<int> newIndexOfVertex(vertices.size());
+    for (std::size_t position = 0; position < keys.size(); ++position) {
+        newIndexOfVertex[keys[position].second] = position;
+    }
+    return newIndexOfVertex;
+}
+
+/**
+ * Orders the vertices by the reverse Cuthill-McKee algorithm: a breadth-first search from a
+ * vertex of minimum degree in each component that visits neighbors by increasing degree,
+ * reversed at the end.
+ */
+inline std::vector<int> ReverseCuthillMcKeeOrder(const DataStructures::Instance& instance) {
+    const int numberOfVertices = instance.NumberOfNodes();
+    std::vector<std::vector<int>> neighbors(numberOfVertices);
+    for (const DataStructures::InstanceEdge& edge : instance.Edges()) {
+        neighbors[edge.source].push_back(edge.target);
+        neighbors[edge.target].push_back(edge.source);
+    }
+    auto ByDegree = [&neighbors](int first, int second) {
+        return std::make_pair(neighbors[first].size(), first) < std::make_pair(neighbors[second].size(), second);
+    };
+    for (std::vector<int>& adjacent : neighbors) {
+        std::sort(adjacent.begin(), adjacent.end(), ByDegree);
+    }
+
+    std::vector<int> verticesByDegree(numberOfVertices);
+    for (int vertex = 0; vertex < numberOfVertices; ++vertex) { verticesByDegree[vertex] = vertex; }
+    std::sort(verticesByDegree.begin(), verticesByDegree.end(), ByDegree);
+
+    std::vector<int> order;
+    order.reserve(numberOfVertices);
+    std::vector<bool> isVisited(numberOfVertices, false);
+    for (int start : verticesByDegree) {
+        if (isVisited[start]) { continue; }
+        isVisited[start] = true;
+        // order serves as the queue of the breadth-first search
+        std::size_t next = order.size();
+        order.push_back(start);
+        for (; next < order.size(); ++next) {
+            for (int neighbor : neighbors[order[next]]) {
+                if (isVisited[neighbor]) { continue; }
+                isVisited[neighbor] = true;
+                order.push_back(neighbor);
+            }
+        }
+    }
+
+    std::vector<int> newIndexOfVertex(numberOfVertices);
+    for (int position = 0; position < numberOfVertices; ++position) {
+        newIndexOfVertex[order[position]] = numberOfVertices - 1 - position;
+    }
+    return newIndexOfVertex;
+}
+
+/**
+ * Renumbers instance by the given order: "HILBERT", "RCM" or "NONE".
+ */
+inline void RenumberInstance(DataStructures::Instance& instance, const std::string& order) {
+    if (order == "HILBERT") {
+        instance.Renumber(HilbertOrder(instance));
+    } else if (order == "RCM") {
+        instance.Renumber(ReverseCuthillMcKeeOrder(instance));
+    } else if (order != "NONE") {
+        throw "Could not identify the vertex order '" + order + "'.";
+    }
+}
+
+} // namespace Algorithms
+
+} // namespace wcp
+
+#endif
@@ -0,0 +1,71 @@
+#ifndef API_SOLVER
+#define API_SOLVER
+
+#include <vector>
+
+#include "Api/SolverOptions.h"
+
+#include "Auxiliary/Constants.h"
+#include "Auxiliary/ReturnCodes.h"
+
+#include "IO/NegativeCycleSummaryRow.h"
+
+namespace wcp {
+
+namespace Api {
+
+/**
+ * A wind farm given in memory. Vertex i and edge j of the graph become vertex i
+ * and original edge j of the residual graph, so that the flows of a Result are
+ * indexed like edges.
+ */
+struct Graph {
+    struct Vertex {
+        double x = 0;
+        double y = 0;
+        bool isSubstation = false;
+        int capacity = 0;   ///< Only used for substations
+    };
+
+    struct Edge {
+        int source = 0;
+        int target = 0;
+    };
+
+    std::vector<Vertex> vertices;
+    std::vector<Edge> edges;
+
+    /**
+     * The cable types, by default the ones of the command-line tool.
+     */
+    std::vector<int> cableCapacities = {5, 8, 12, 15};
+    std::vector<int> cableCosts      = {20, 25, 27, 41};
+};
+
+struct Result {
+    ReturnCode status = ReturnCode::IN_PROGRESS;
+    double cost = Auxiliary::DINFTY;
+
+    /**
+     * The flow on each edge of the graph, positive if it goes from source to target.
+     */
+    std::vector<int> flowOnEdges;
+
+    /**
+     * Running times and counters of the run as they appear in the summary of the command-line tool.
+     */
+    IO::NegativeCycleSummaryRow statistics;
+};
+
+/**
+ * Solves the wind farm cabling problem on graph with the NCC variant of options.
+ * Needs neither Qt nor any files, and can be called from several threads at once.
+ * Throws a string if graph or options are invalid.
+ */
+Result Solve(const Graph& graph, const SolverOptions& options);
+
+} // namespace Api
+
+} // namespace wcp
+
+#endif
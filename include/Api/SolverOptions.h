@@ -0,0 +1,214 @@
+#ifndef API_SOLVEROPTIONS
+#define API_SOLVEROPTIONS
+
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "Algorithms/NCCSettings.h"
+
+#include "Auxiliary/Constants.h"
+
+#include "DataStructures/StrategyNames.h"
+
+namespace wcp {
+
+namespace Api {
+
+enum class Algorithm {
+    NCC,
+    ESCAPING_NCC
+};
+
+/**
+ * Edge lengths of the shortest paths during the initialization.
+ */
+enum class PathLength {
+    EUCLIDEAN,  ///< DIJKSTRA
+    UNIT        ///< BFS
+};
+
+/**
+ * Which substation with free capacity a turbine is routed to during the initialization.
+ */
+enum class TargetSubstation {
+    ANY_FREE,   ///< ANY: the closest one
+    LAST_FREE   ///< LAST: the farthest one
+};
+
+enum class DeltaStrategy {
+    INCREASING,             ///< INC
+    DECREASING,             ///< DEC
+    INCREASING_DECREASING,  ///< INCDEC
+    RANDOM,                 ///< RANDOM
+    ADAPTIVE                ///< ADAPTIVE
+};
+
+enum class Detection {
+    BELLMAN_FORD,                   ///< BF
+    SIDE_TRIP_FREE_BELLMAN_FORD     ///< STFBF
+};
+
+/**
+ * Typed options of a solver run, the counterpart of the command-line options.
+ * The default values are the defaults of the command-line tool.
+ */
+struct SolverOptions {
+    Algorithm algorithm = Algorithm::NCC;
+
+    bool collectingInitialization = false;
+    PathLength initializationPathLength = PathLength::EUCLIDEAN;
+    TargetSubstation initializationTarget = TargetSubstation::ANY_FREE;
+
+    /**
+     * If not empty, NCC starts from this flow on the original edges instead of
+     * computing an initial flow, see Algorithms::FlowFromFile.
+     */
+    std::vector<int> initialFlow;
+
+    DeltaStrategy deltaStrategy = DeltaStrategy::INCREASING;
+    bool stayOnSuccessfulDelta = false;  ///< STAY
+
+    Detection detection = Detection::SIDE_TRIP_FREE_BELLMAN_FORD;
+
+    int randomSeed = 0;
+    double timeLimitInSeconds = Auxiliary::DINFTY;
+    unsigned int iterationLimit = std::numeric_limits<unsigned int>::max();
+
+    /**
+     * Weights of the escaping strategies of EscapingNCC; at least one has to be positive.
+     */
+    unsigned int weightEscapeLeaves = 0;
+    unsigned int weightEscapeBonbon = 0;
+    unsigned int weightEscapeFreeCables = 0;
+
+    Algorithms::NCCSettings settings;
+};
+
+/**
+ * Sets the initialization of options from a name of form '(COLLECTING)?(DIJKSTRA|BFS)(ANY|LAST)'.
+ * Throws a string if the name is not of this form.
+ */
+inline void ParseInitialization(const std::string& name, SolverOptions& options) {
+    const std::string error = "Could not identify a suitable initialization strategy from your input '" + name
+                                + "'. Your input must be of format '(COLLECTING)?(DIJKSTRA|BFS)(ANY|LAST)'.";
+    std::string rest(name);
+    auto ChopSuffix = [&rest](const std::string& suffix) {
+        if (rest.size() < suffix.size() || rest.compare(rest.size() - suffix.size(), suffix.size(), suffix) != 0) {
+            return false;
+        }
+        rest.resize(rest.size() - suffix.size());
+        return true;
+    };
+
+    if (ChopSuffix("ANY")) {
+        options.initializationTarget = TargetSubstation::ANY_FREE;
+    } else if (ChopSuffix("LAST")) {
+        options.initializationTarget = TargetSubstation::LAST_FREE;
+    } else {
+        throw error;
+    }
+
+    if (ChopSuffix("BFS")) {
+        options.initializationPathLength = PathLength::UNIT;
+    } else if (ChopSuffix("DIJKSTRA")) {
+        options.initializationPathLength = PathLength::EUCLIDEAN;
+    } else {
+        throw error;
+    }
+
+    if (rest == "COLLECTING") {
+        options.collectingInitialization = true;
+    } else if (rest.empty()) {
+        options.collectingInitialization = false;
+    } else {
+        throw error;
+    }
+}
+
+/**
+ * Sets the delta strategy of options from a name of form '(STAY)?(INC|DEC|INCDEC|RANDOM|ADAPTIVE)'.
+ * Throws a string if the name is not of this form.
+ */
+inline void ParseDeltaStrategy(const std::string& name, SolverOptions& options) {
+    const std::string error = "Could not identify a suitable delta strategy from your input '" + name
+                                + "'. Your input must be of the form '(STAY)?(INC|DEC|INCDEC|RANDOM|ADAPTIVE)'.";
+    std::string rest(name);
+    auto ChopSuffix = [&rest](const std::string& suffix) {
+        if (rest.size() < suffix.size() || rest.compare(rest.size() - suffix.size(), suffix.size(), suffix) != 0) {
+            return false;
+        }
+        rest.resize(rest.size() - suffix.size());
+        return true;
+    };
+
+    // INCDEC has to be checked before INC and DEC
+    if (ChopSuffix("INCDEC")) {
+        options.deltaStrategy = DeltaStrategy::INCREASING_DECREASING;
+    } else if (ChopSuffix("INC")) {
+        options.deltaStrategy = DeltaStrategy::INCREASING;
+    } else if (ChopSuffix("DEC")) {
+        options.deltaStrategy = DeltaStrategy::DECREASING;
+    } else if (ChopSuffix("RANDOM")) {
+        options.deltaStrategy = DeltaStrategy::RANDOM;
+    } else if (ChopSuffix("ADAPTIVE")) {
+        options.deltaStrategy = DeltaStrategy::ADAPTIVE;
+    } else {
+        throw error;
+    }
+
+    if (rest == "STAY") {
+        options.stayOnSuccessfulDelta = true;
+    } else if (rest.empty()) {
+        options.stayOnSuccessfulDelta = false;
+    } else {
+        throw error;
+    }
+}
+
+/**
+ * Sets the detection of options from 'BF' or 'STFBF'. Throws a string otherwise.
+ */
+inline void ParseDetection(const std::string& name, SolverOptions& options) {
+    if (name == "STFBF") {
+        options.detection = Detection::SIDE_TRIP_FREE_BELLMAN_FORD;
+    } else if (name == "BF") {
+        options.detection = Detection::BELLMAN_FORD;
+    } else {
+        throw "Could not identify a suitable detection strategy from your input '" + name
+                + "'. Your input must be 'BF' or 'STFBF'.";
+    }
+}
+
+/**
+ * Returns the names of the strategies in options as they are given on the command line.
+ */
+inline DataStructures::StrategyNames StrategyNamesOf(const SolverOptions& options) {
+    DataStructures::StrategyNames names;
+
+    if (!options.initialFlow.empty()) {
+        names.initialization = "FROMFILE";
+    } else {
+        names.initialization = std::string(options.collectingInitialization ? "COLLECTING" : "")
+                                + (options.initializationPathLength == PathLength::UNIT ? "BFS" : "DIJKSTRA")
+                                + (options.initializationTarget == TargetSubstation::LAST_FREE ? "LAST" : "ANY");
+    }
+
+    names.delta = options.stayOnSuccessfulDelta ? "STAY" : "";
+    switch (options.deltaStrategy) {
+        case DeltaStrategy::INCREASING:             names.delta += "INC";       break;
+        case DeltaStrategy::DECREASING:             names.delta += "DEC";       break;
+        case DeltaStrategy::INCREASING_DECREASING:  names.delta += "INCDEC";    break;
+        case DeltaStrategy::RANDOM:                 names.delta += "RANDOM";    break;
+        case DeltaStrategy::ADAPTIVE:               names.delta += "ADAPTIVE";  break;
+    }
+
+    names.detection = (options.detection == Detection::BELLMAN_FORD) ? "BF" : "STFBF";
+    return names;
+}
+
+} // namespace Api
+
+} // namespace wcp
+
+#endif
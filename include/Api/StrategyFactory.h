@@ -0,0 +1,53 @@
+#ifndef API_STRATEGYFACTORY
+#define API_STRATEGYFACTORY
+
+#include <memory>
+#include <ostream>
+
+#include "Algorithms/DeltaStrategies/DeltaStrategy.h"
+#include "Algorithms/DetectionStrategies/NegativeCycleDetection.h"
+#include "Algorithms/EscapeStrategies/KeeperOfEscapingStrategies.h"
+#include "Algorithms/InitializationStrategies/InitializationStrategy.h"
+#include "Algorithms/SharedIncumbent.h"
+
+#include "Api/SolverOptions.h"
+
+#include "DataStructures/Graphs/WindfarmResidual.h"
+#include "DataStructures/Instance.h"
+
+#include "IO/NCCLogger.h"
+
+namespace wcp {
+
+namespace Api {
+
+/**
+ * Returns the initialization of options; a FlowFromFile if options has an initial flow.
+ */
+std::unique_ptr<Algorithms::InitializationStrategy> ConstructInitializationStrategy(const SolverOptions& options, DataStructures::WindfarmResidual& windfarm);
+
+std::unique_ptr<Algorithms::DeltaStrategy> ConstructDeltaStrategy(const SolverOptions& options, const DataStructures::Instance& instance);
+
+std::unique_ptr<Algorithms::NegativeCycleDetection> ConstructDetectionStrategy(const SolverOptions& options, DataStructures::WindfarmResidual& windfarm);
+
+std::unique_ptr<Algorithms::KeeperOfEscapingStrategies> ConstructEscapingStrategies(const SolverOptions& options, DataStructures::WindfarmResidual& windfarm);
+
+/**
+ * Runs the NCC variant of options on windfarm with the given initialization strategy.
+ * Throws a string if EscapingNCC is requested without any escaping strategy.
+ */
+void RunNCC(DataStructures::Instance& instance,
+            DataStructures::WindfarmResidual& windfarm,
+            IO::NCCLogger& logger,
+            const SolverOptions& options,
+            std::unique_ptr<Algorithms::InitializationStrategy> initializationStrategy,
+            double timeLimitInMilliseconds,
+            bool beVerbose,
+            std::ostream& verboseStream,
+            Algorithms::SharedIncumbent* sharedIncumbent = nullptr);
+
+} // namespace Api
+
+} // namespace wcp
+
+#endif
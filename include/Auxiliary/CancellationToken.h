@@ -0,0 +1,80 @@
+#ifndef AUXILIARY_CANCELLATIONTOKEN
+#define AUXILIARY_CANCELLATIONTOKEN
+
+#include <atomic>
+#include <csignal>
+
+#include "Auxiliary/Constants.h"
+#include "Auxiliary/Timer.h"
+
+namespace wcp {
+
+namespace Auxiliary {
+
+/**
+ * A flag to abort long computations cooperatively, e.g., a single run of
+ * Bellman-Ford or Dijkstra. A token is cancelled if Cancel() was called,
+ * if its deadline on the given timer has passed, or if the process received
+ * SIGINT or SIGTERM after InstallSignalHandlers().
+ *
+ * Inner loops should call IsCancelledAfterManyCalls(), which only reads the
+ * clock every CHECK_INTERVAL calls.
+ */
+class CancellationToken {
+public:
+    CancellationToken(Timer& timer, double deadlineInMilliseconds = DINFTY)
+      : timer_(timer),
+        deadlineInMilliseconds_(deadlineInMilliseconds),
+        isCancelled_(false),
+        numberOfCallsSinceLastCheck_(0) {}
+
+    void Cancel() { isCancelled_.store(true, std::memory_order_relaxed); }
+
+    bool IsCancelled() {
+        if (isCancelled_.load(std::memory_order_relaxed)) { return true; }
+        if (HasReceivedSignal() || timer_.ElapsedMilliseconds() > deadlineInMilliseconds_) {
+            Cancel();
+            return true;
+        }
+        return false;
+    }
+
+    bool IsCancelledAfterManyCalls() {
+        if (++numberOfCallsSinceLastCheck_ < CHECK_INTERVAL) { return false; }
+        numberOfCallsSinceLastCheck_ = 0;
+        return IsCancelled();
+    }
+
+    /**
+     * Lets SIGINT and SIGTERM cancel all tokens, so that the algorithms
+     * stop soon and their best solution is still written.
+     */
+    static void InstallSignalHandlers() {
+        SignalReceived().store(false);
+        std::signal(SIGINT, HandleSignal);
+        std::signal(SIGTERM, HandleSignal);
+    }
+
+    static bool HasReceivedSignal() { return SignalReceived().load(std::memory_order_relaxed); }
+
+private:
+    static std::atomic<bool>& SignalReceived() {
+        static std::atomic<bool> signalReceived(false);
+        return signalReceived;
+    }
+
+    static void HandleSignal(int /*signal*/) { SignalReceived().store(true); }
+
+    Timer& timer_;
+    double deadlineInMilliseconds_;
+    std::atomic<bool> isCancelled_;
+    unsigned int numberOfCallsSinceLastCheck_;
+
+    static constexpr unsigned int CHECK_INTERVAL = 1024;
+};
+
+} // namespace Auxiliary
+
+} // namespace wcp
+
+#endif
@@ -0,0 +1,46 @@
+#ifndef AUXILIARY_EPOCHMARKS
+#define AUXILIARY_EPOCHMARKS
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace wcp {
+
+namespace Auxiliary {
+
+/**
+ * A set of indices that can be cleared in constant time. An index is marked
+ * if its entry equals the current epoch, so Clear() only increments the epoch
+ * and the memory is reused by all later traversals instead of allocating a
+ * std::vector<bool> per traversal.
+ */
+class EpochMarks {
+public:
+    /**
+     * Unmarks all indices and makes room for the indices 0, ..., size-1.
+     */
+    void Clear(std::size_t size) {
+        if (marks_.size() < size) { marks_.resize(size, 0); }
+        if (epoch_ == std::numeric_limits<std::uint32_t>::max()) {
+            std::fill(marks_.begin(), marks_.end(), 0);
+            epoch_ = 0;
+        }
+        ++epoch_;
+    }
+
+    bool IsMarked(std::size_t index) const { return marks_[index] == epoch_; }
+    void Mark(std::size_t index) { marks_[index] = epoch_; }
+
+private:
+    std::vector<std::uint32_t> marks_;
+    std::uint32_t epoch_ = 0;
+};
+
+} // namespace Auxiliary
+
+} // namespace wcp
+
+#endif
@@ -0,0 +1,129 @@
+#ifndef AUXILIARY_THREADPOOL
+#define AUXILIARY_THREADPOOL
+
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace wcp {
+
+namespace Auxiliary {
+
+/**
+ * A fixed set of worker threads that process submitted tasks in FIFO order.
+ *
+ * Exceptions thrown by a task are caught in the worker thread. The first
+ * one is rethrown by WaitForAll() so that the error handling in main()
+ * also covers work done in parallel.
+ */
+class ThreadPool {
+public:
+    /**
+     * Starts numberOfThreads workers. A value of 0 uses one worker per hardware thread.
+     */
+    explicit ThreadPool(unsigned int numberOfThreads = 0)
+      : numberOfRunningTasks_(0),
+        shuttingDown_(false)
+    {
+        if (numberOfThreads == 0) { numberOfThreads = DefaultNumberOfThreads(); }
+        for (unsigned int i = 0; i < numberOfThreads; ++i) {
+            workers_.emplace_back([this] { ProcessTasks(); });
+        }
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    void operator=(const ThreadPool&) = delete;
+
+    ~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            shuttingDown_ = true;
+        }
+        taskAvailable_.notify_all();
+        for (std::thread& worker : workers_) {
+            worker.join();
+        }
+    }
+
+    void Submit(std::function<void()> task) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            tasks_.push(std::move(task));
+        }
+        taskAvailable_.notify_one();
+    }
+
+    /**
+     * Blocks until all submitted tasks are completed. Rethrows the first
+     * exception that a task has thrown since the last call.
+     */
+    void WaitForAll() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        allTasksDone_.wait(lock, [this] { return tasks_.empty() && numberOfRunningTasks_ == 0; });
+        if (firstException_) {
+            std::exception_ptr exception = firstException_;
+            firstException_ = nullptr;
+            std::rethrow_exception(exception);
+        }
+    }
+
+    std::size_t NumberOfThreads() const { return workers_.size(); }
+
+    static unsigned int DefaultNumberOfThreads() {
+        unsigned int numberOfHardwareThreads = std::thread::hardware_concurrency();
+        return (numberOfHardwareThreads > 0) ? numberOfHardwareThreads : 1;
+    }
+
+private:
+    void ProcessTasks() {
+        while (true) {
+            std::function<void()> task;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                taskAvailable_.wait(lock, [this] { return shuttingDown_ || !tasks_.empty(); });
+                if (tasks_.empty()) { return; } // only reached when shutting down
+                task = std::move(tasks_.front());
+                tasks_.pop();
+                ++numberOfRunningTasks_;
+            }
+
+            try {
+                task();
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (!firstException_) { firstException_ = std::current_exception(); }
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                --numberOfRunningTasks_;
+                if (tasks_.empty() && numberOfRunningTasks_ == 0) {
+                    allTasksDone_.notify_all();
+                }
+            }
+        }
+    }
+
+    std::vector<std::thread> workers_;
+    std::queue<std::function<void()>> tasks_;
+
+    std::mutex mutex_;
+    std::condition_variable taskAvailable_;
+    std::condition_variable allTasksDone_;
+
+    std::size_t numberOfRunningTasks_;
+    bool shuttingDown_;
+    std::exception_ptr firstException_;
+};
+
+} // namespace Auxiliary
+
+} // namespace wcp
+
+#endif
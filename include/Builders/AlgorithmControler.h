@@ -30,6 +30,26 @@ public:
         }
     }
 
+    /**
+     * Solves all instances of the batch given in inputInformation.
+     */
+    virtual void BuildAndRunBatchAndOutput( DataStructures::InputInformation& /*inputInformation*/,
+                                            const DataStructures::OutputInformation& outputInformation) {
+        if (outputInformation.ShouldBeVerbose()) {
+            outputInformation.VerboseStream() << "Nothing to do. Terminate." <<std::endl;
+        }
+    }
+
+    /**
+     * Keeps the process resident and solves the requests of clients.
+     */
+    virtual void Serve( DataStructures::InputInformation& /*inputInformation*/,
+                        const DataStructures::OutputInformation& outputInformation) {
+        if (outputInformation.ShouldBeVerbose()) {
+            outputInformation.VerboseStream() << "Nothing to do. Terminate." <<std::endl;
+        }
+    }
+
     const std::string& AlgorithmName() const { return algorithmName_; }
 protected:
     const std::string algorithmName_;
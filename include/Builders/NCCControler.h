@@ -1,14 +1,19 @@
 #ifndef BUILDERS_NCCCONTROLER
 #define BUILDERS_NCCCONTROLER
 
+#include <fstream>
 #include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
 #include <QString>
 
-#include "Algorithms/EscapeStrategies/EscapingStrategy.h"
-#include "Algorithms/EscapeStrategies/KeeperOfEscapingStrategies.h"
 #include "Algorithms/InitializationStrategies/InitializationStrategy.h"
-#include "Algorithms/DeltaStrategies/DeltaStrategy.h"
-#include "Algorithms/DetectionStrategies/NegativeCycleDetection.h"
+#include "Algorithms/NCCSettings.h"
+#include "Algorithms/SharedIncumbent.h"
+
+#include "Api/SolverOptions.h"
 
 #include "Builders/AlgorithmControler.h"
 
@@ -17,6 +22,8 @@
 #include "DataStructures/OutputInformation.h"
 #include "DataStructures/Graphs/WindfarmResidual.h"
 
+#include "IO/IncumbentStream.h"
+#include "IO/NCCLogger.h"
 #include "IO/NegativeCycleRuntimeCollection.h"
 #include "IO/NegativeCycleSummaryRow.h"
 
@@ -24,6 +31,24 @@ namespace wcp {
 
 namespace Builders {
 
+/**
+ * One of several NCC runs in parallel together with its own flow and bookkeeping.
+ * The instance and the topology of the wind farm are shared between all runs and
+ * are only read during the runs. The windfarm is a copy of windfarmWithoutFlow.
+ */
+struct ParallelNCCRun {
+    ParallelNCCRun(const Algorithms::WindfarmResidual& windfarmWithoutFlow, const DataStructures::InputInformation& input)
+      : inputInformation(input),
+        windfarm(windfarmWithoutFlow) {
+        // The runs already occupy all threads, so subproblems of a run are solved on its own thread
+        inputInformation.numberOfThreads_ = 1;
+    }
+
+    DataStructures::InputInformation inputInformation;
+    Algorithms::WindfarmResidual windfarm;
+    IO::NCCLogger logger;
+};
+
 /**
  * A builder class for all kinds of Negative Cycle Canceling.
  */
@@ -32,13 +57,19 @@ public:
     NCCControler(const std::string& algorithmName) 
       : AlgorithmControler(algorithmName) {};
 
-    std::unique_ptr<Algorithms::InitializationStrategy> ConstructInitializationStrategy(QString& initializationInputString, Algorithms::WindfarmResidual& windfarm);
+    /**
+     * Parses the strategies in inputInformation into typed options. Throws a string if a strategy is unknown.
+     * The initial flow of a warm start is not read.
+     */
+    Api::SolverOptions SolverOptionsOf(const DataStructures::InputInformation& inputInformation);
 
-    std::unique_ptr<Algorithms::DeltaStrategy> ConstructDeltaStrategy(QString& deltaInputString, int seedInput, DataStructures::Instance& instance);
+    Algorithms::NCCSettings ConstructNCCSettings(const DataStructures::InputInformation& inputInformation);
 
-    std::unique_ptr<Algorithms::NegativeCycleDetection> ConstructDetectionStrategy(QString& detectionInputString, Algorithms::WindfarmResidual& windfarm);
-
-    std::unique_ptr<Algorithms::KeeperOfEscapingStrategies> ConstructEscapingStrategies(DataStructures::InputInformation& inputInformation, Algorithms::WindfarmResidual& windfarm);
+    /**
+     * Opens the stream for improvements during the run if requested. All runs share it.
+     * Edges are streamed with their index in the input file of the instance.
+     */
+    void SetUpIncumbentStream(const DataStructures::Instance& instance, const DataStructures::InputInformation& inputInformation);
 
     double DetermineAndOutputTimeLimit(DataStructures::InputInformation& inputInformation, const DataStructures::OutputInformation& outputInformation);
 
@@ -48,9 +79,105 @@ public:
                                 DataStructures::InputInformation& inputInformation,
                                 const DataStructures::OutputInformation& outputInformation);
 
+    /**
+     * Constructs the strategies given in inputInformation and runs the corresponding NCC variant on windfarm.
+     * If incumbentStream is given, it replaces the stream set up by SetUpIncumbentStream for this run.
+     */
+    void BuildAndRun(   DataStructures::Instance& instance,
+                        Algorithms::WindfarmResidual& windfarm,
+                        IO::NCCLogger& logger,
+                        DataStructures::InputInformation& inputInformation,
+                        double timeLimitInMilliseconds,
+                        bool beVerbose,
+                        std::ostream& verboseStream,
+                        Algorithms::SharedIncumbent* sharedIncumbent = nullptr,
+                        IO::IncumbentStream* incumbentStream = nullptr);
+
+    /**
+     * Runs the NCC variant given in inputInformation on windfarm starting from its current feasible
+     * flow instead of an initial flow, e.g., after editing the wind farm with an Algorithms::TopologyEditor.
+     * The instance is not updated by such edits, so an edited wind farm cannot be output through
+     * IO::NCCLogger::CompleteOutput, which throws in that case (see WindfarmResidual::HasEditedTopology).
+     */
+    void Reoptimize(DataStructures::Instance& instance,
+                    Algorithms::WindfarmResidual& windfarm,
+                    IO::NCCLogger& logger,
+                    DataStructures::InputInformation& inputInformation,
+                    double timeLimitInMilliseconds,
+                    bool beVerbose,
+                    std::ostream& verboseStream);
+
+    /**
+     * Runs the NCC variant given in inputInformation on windfarm with the given initialization strategy.
+     */
+    void RunWithInitialization( DataStructures::Instance& instance,
+                                Algorithms::WindfarmResidual& windfarm,
+                                IO::NCCLogger& logger,
+                                DataStructures::InputInformation& inputInformation,
+                                std::unique_ptr<Algorithms::InitializationStrategy> initializationStrategy,
+                                double timeLimitInMilliseconds,
+                                bool beVerbose,
+                                std::ostream& verboseStream,
+                                Algorithms::SharedIncumbent* sharedIncumbent,
+                                IO::IncumbentStream* incumbentStream);
+
+    /**
+     * Runs all strategy combinations of the portfolio in parallel and outputs the best one.
+     */
+    void BuildAndRunPortfolioAndOutput( DataStructures::Instance& instance,
+                                        DataStructures::InputInformation& inputInformation,
+                                        const DataStructures::OutputInformation& outputInformation);
+
+    /**
+     * Runs several chains of EscapingNCC with different seeds in parallel that share their best flow, and outputs the best chain.
+     */
+    void BuildAndRunChainsAndOutput(DataStructures::Instance& instance,
+                                    DataStructures::InputInformation& inputInformation,
+                                    const DataStructures::OutputInformation& outputInformation);
+
+    /**
+     * Solves each instance of the batch with each strategy combination of the grid. The instances
+     * are distributed over a thread pool, and the output of all runs goes to shared files.
+     */
+    void BuildAndRunBatchAndOutput( DataStructures::InputInformation& inputInformation,
+                                    const DataStructures::OutputInformation& outputInformation);
+
+    /**
+     * Reads one instance of the batch and runs all combinations on it one after the other,
+     * reusing its residual graph. Output is written while holding outputMutex.
+     */
+    void RunBatchInstance(  const std::string& instanceFile,
+                            const std::vector<DataStructures::InputInformation>& combinations,
+                            double timeLimitInMilliseconds,
+                            const DataStructures::OutputInformation& outputInformation,
+                            std::mutex& outputMutex);
+
+    /**
+     * Runs all runs on a thread pool under the shared time limit and outputs the run with the best solution.
+     */
+    void RunInParallelAndOutputBest(DataStructures::Instance& instance,
+                                    std::vector<std::unique_ptr<ParallelNCCRun>>& runs,
+                                    DataStructures::InputInformation& inputInformation,
+                                    const DataStructures::OutputInformation& outputInformation,
+                                    Algorithms::SharedIncumbent* sharedIncumbent);
+
+    /**
+     * Keeps the process resident and solves requests from standard in or a UNIX domain socket (see SolverServer).
+     */
+    void Serve(DataStructures::InputInformation& inputInformation, const DataStructures::OutputInformation& outputInformation);
+
+    /**
+     * Splits a portfolio or grid of form 'INIT:DELTA:DETECT(,INIT:DELTA:DETECT)*' into one input per combination.
+     */
+    std::vector<DataStructures::InputInformation> ParsePortfolio(const DataStructures::InputInformation& inputInformation, const QString& portfolio);
+
     void AddMetaToSummary(  IO::NegativeCycleSummaryRow& summaryRow,
                             DataStructures::Instance& instance,
                             DataStructures::InputInformation& inputInformation);
+
+private:
+    std::unique_ptr<std::ofstream> incumbentStreamFile_;
+    std::unique_ptr<IO::IncumbentStream> incumbentStream_;
 };
 
 } // namespace Builders
@@ -0,0 +1,107 @@
+#ifndef BUILDERS_SOLVERSERVER
+#define BUILDERS_SOLVERSERVER
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "Auxiliary/ThreadPool.h"
+
+#include "DataStructures/Graphs/WindfarmResidual.h"
+#include "DataStructures/InputInformation.h"
+#include "DataStructures/Instance.h"
+
+#include "IO/ServerProtocol.h"
+
+namespace wcp {
+
+namespace Builders {
+
+class NCCControler;
+
+/**
+ * A parsed instance that is kept between requests, together with the residual
+ * graphs that are currently not in use. Requests on the same instance that run
+ * in parallel each take their own residual graph, which is a copy of the first
+ * one and shares its topology.
+ */
+struct CachedInstance {
+    std::string content;
+    std::unique_ptr<DataStructures::Instance> instance;
+
+    std::mutex mutex;
+    std::unique_ptr<const DataStructures::WindfarmResidual> windfarmWithoutFlow;
+    std::vector<std::unique_ptr<DataStructures::WindfarmResidual>> idleWindfarms;
+};
+
+/**
+ * Keeps the process resident and answers requests of the line-delimited JSON
+ * protocol in IO::ServerProtocol, either on standard in and out or on a UNIX
+ * domain socket. Requests are solved in parallel on a thread pool. Instances are
+ * cached by the hash of their GML text, so that repeated requests on the same
+ * wind farm skip parsing and the construction of the residual graph.
+ */
+class SolverServer {
+public:
+    /**
+     * The options in defaults apply to each request that does not override them.
+     */
+    SolverServer(NCCControler& controler, const DataStructures::InputInformation& defaults);
+
+    /**
+     * Answers requests until standard in is closed or the process receives SIGINT or SIGTERM.
+     */
+    void ServeStandardStreams();
+
+    /**
+     * Listens on socketPath and serves one client at a time until the process receives SIGINT or SIGTERM.
+     */
+    void ServeUnixSocket(const std::string& socketPath);
+
+private:
+    using LineWriter = std::function<void(const std::string&)>;
+
+    /**
+     * Reads requests from inputDescriptor and writes the responses to outputDescriptor.
+     * Returns after all requests of the input are answered.
+     */
+    void ServeFileDescriptors(int inputDescriptor, int outputDescriptor);
+
+    /**
+     * Solves one request and writes its responses. Errors are reported as responses.
+     */
+    void HandleRequest(const std::string& line, const LineWriter& writeLine);
+
+    std::shared_ptr<CachedInstance> LoadInstance(const IO::ServerProtocol::Request& request, bool& wasCached);
+
+    /**
+     * Drops cached instances that no request uses anymore, if the cache is full. Expects cacheMutex_ to be held.
+     */
+    void EvictUnusedInstancesIfFull();
+
+    std::unique_ptr<DataStructures::WindfarmResidual> AcquireWindfarm(CachedInstance& cachedInstance);
+
+    void ReleaseWindfarm(CachedInstance& cachedInstance, std::unique_ptr<DataStructures::WindfarmResidual> windfarm);
+
+    NCCControler& controler_;
+    const DataStructures::InputInformation defaults_;
+    Auxiliary::ThreadPool threadPool_;
+
+    std::mutex cacheMutex_;
+    // Instances by the hash of their content; a bucket only holds several instances on collisions
+    std::unordered_map<std::size_t, std::vector<std::shared_ptr<CachedInstance>>> cache_;
+    std::size_t numberOfCachedInstances_;
+
+    static const std::size_t MAXIMUM_NUMBER_OF_CACHED_INSTANCES = 64;
+    static const int POLL_INTERVAL_IN_MILLISECONDS = 200;
+};
+
+} // namespace Builders
+
+} // namespace wcp
+
+#endif
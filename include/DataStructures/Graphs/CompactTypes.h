@@ -0,0 +1,31 @@
+#ifndef DATASTRUCTURES_GRAPHS_COMPACTTYPES
+#define DATASTRUCTURES_GRAPHS_COMPACTTYPES
+
+#include <cstdint>
+
+namespace wcp {
+
+namespace DataStructures {
+
+/**
+ * Types in which the wind farm stores edge lengths, flows and residual costs.
+ * The accessors always take and return int and double. With the build option
+ * WCP_COMPACT, the values are stored in smaller types to fit wind farms with
+ * tens of thousands of turbines into cache and memory, at the price of float
+ * precision for lengths and residual costs and at most 32767 turbines.
+ */
+#ifdef WCP_COMPACT
+using StoredLength  = float;
+using StoredFlow    = std::int16_t;
+using StoredCost    = float;
+#else
+using StoredLength  = double;
+using StoredFlow    = int;
+using StoredCost    = double;
+#endif
+
+} // namespace DataStructures
+
+} // namespace wcp
+
+#endif
@@ -54,14 +54,6 @@ public:
         return _identifier;
     }
 
-    const std::vector<int>& IncidentEdges() const {
-        return _incidentEdges;
-    }
-
-    std::vector<int>& IncidentEdges() {
-        return _incidentEdges;
-    }
-
     const std::vector<int>& OutgoingEdges() const {
         return _outgoingEdges;
     }
@@ -114,12 +106,6 @@ private:
      * needed for WindfarmResidual.h
      */
     std::vector<int> _outgoingEdges;
-
-    /**
-     * Includes indices of all incident edges, including supersubstation-edges,
-     * needed for WindfarmCMST.h
-     */
-    std::vector<int> _incidentEdges;
 };
 
 } // namespace DataStructures
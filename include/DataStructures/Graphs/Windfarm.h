@@ -2,6 +2,8 @@
 #define DATASTRUCTURES_GRAPHS_WINDFARM
 
 #include <cassert>
+#include <memory>
+#include <utility>
 #include <vector>
 
 #include <ogdf/basic/basic.h>
@@ -24,37 +26,68 @@ namespace wcp {
 
 namespace DataStructures {
 
+/**
+ * The vertices, edges and adjacency lists of a wind farm, which do not change
+ * while a flow is computed. Copies of a wind farm share their topology.
+ */
+struct WindfarmTopology {
+    WindfarmTopology(int numberOfVertices, int numberOfEdges, const wcp::DataStructures::Cabletypes& cabletypesOfInstance)
+      : numberOfOriginalVertices(numberOfVertices),
+        numberOfOriginalEdges(numberOfEdges),
+        numberOfTurbines(0),
+        numberOfSubstations(0),
+        listOfVertices(numberOfVertices + 1, Vertex()),
+        cabletypes(&cabletypesOfInstance) {}
+
+    int numberOfOriginalVertices; // number of vertices as in gml-file
+    int numberOfOriginalEdges; // number of edges as in gml-file
+    int numberOfTurbines;
+    int numberOfSubstations;
+
+    std::vector<Vertex>   listOfVertices; // vector of original vertices with supersubstation as last entry
+
+    std::vector<Edge>     listOfEdges; // vector of original edges and edges between substation and supersubstation
+
+    std::vector<vertexID> turbineIdentifiers;
+    std::vector<vertexID> substationIdentifiers;
+
+    const wcp::DataStructures::Cabletypes* cabletypes;
+};
+
 /**
  * Base class for the wind farms.
  *
  * This wind farm contains only the vertices of the graph and not the edges.
  * The subclasses are responsible to store the edges because different algorithms
  * have different requirements regarding which and how edges are stored.
+ *
+ * Vertices and edges are kept in a WindfarmTopology. Copying a wind farm only
+ * copies the state of the subclass, e.g., the flow, and shares the topology
+ * with the original. The first edit of a shared topology copies it.
  */
 struct Windfarm {
 public:
     Windfarm(const Instance& instance);
 
-    int NumberOfOriginalVertices() const { return numberOfOriginalVertices_; }     ///< returns number of vertices without supersubstation
-    int NumberOfVertices()         const { return listOfVertices_.size();    }     ///< returns number of vertices including supersubstation
-    int NumberOfTurbines()         const { return numberOfTurbines_;         }     ///< returns number of turbines
-    int NumberOfSubstations()      const { return numberOfSubstations_;      }     ///< returns number of substations
-    int NumberOfOriginalEdges()    const { return numberOfOriginalEdges_;    }     ///< returns number of original edges without supersubstation edges
-    int NumberOfEdges()            const { return listOfEdges_.size();       }     ///< returns total number of edges including supersubstation edges
+    int NumberOfOriginalVertices() const { return topology_->numberOfOriginalVertices; }    ///< returns number of vertices without supersubstation
+    int NumberOfVertices()         const { return topology_->listOfVertices.size();     }    ///< returns number of vertices including supersubstation
+    int NumberOfTurbines()         const { return topology_->numberOfTurbines;          }    ///< returns number of turbines
+    int NumberOfSubstations()      const { return topology_->numberOfSubstations;       }    ///< returns number of substations
+    int NumberOfOriginalEdges()    const { return topology_->numberOfOriginalEdges;     }    ///< returns number of original edges without supersubstation edges
+    int NumberOfEdges()            const { return topology_->listOfEdges.size();        }    ///< returns total number of edges including supersubstation edges
+
+    /**
+     * Returns the topology, which is shared with all copies of this wind farm until one of them edits it.
+     */
+    std::shared_ptr<const WindfarmTopology> Topology() const { return topology_; }
 
     vertexID SuperSubstationIdentifier() const {
         assert(IsSuperSubstation(NumberOfVertices() - 1));
         return NumberOfVertices() - 1;
     }
 
-    const std::vector<vertexID>& Turbines()    const { return turbineIdentifiers_;   }   ///< returns const reference on vector with turbine identifiers
-    const std::vector<vertexID>& Substations() const { return substationIdentifiers_; }  ///< returns const reference on vector with substation indices without supersubstation
-
-    const std::vector<edgeID>& IncidentEdges(vertexID index) const {
-        assert(index >= 0);
-        assert(index < NumberOfVertices());
-        return VertexAt(index).IncidentEdges();
-    }
+    const std::vector<vertexID>& Turbines()    const { return topology_->turbineIdentifiers;    }   ///< returns const reference on vector with turbine identifiers
+    const std::vector<vertexID>& Substations() const { return topology_->substationIdentifiers; }   ///< returns const reference on vector with substation indices without supersubstation
 
     int VertexCapacity(vertexID index) const {
         assert(index >= 0);
@@ -95,14 +128,6 @@ public:
         return EdgeAt(index).Length();
     }
 
-    /**
-     * Computes and returns Euclidean length of edge from ogdf::GraphAttributes
-     */
-    double Length(ogdf::edge e, const ogdf::GraphAttributes& graphAttributes) const {
-        return std::sqrt(std::pow(graphAttributes.x(e->source()) - graphAttributes.x(e->target()), 2)
-                + std::pow(graphAttributes.y(e->source()) - graphAttributes.y(e->target()), 2));
-    }
-
     int EdgeCapacity(edgeID index) const {
         assert(index >= 0);
         assert(index < NumberOfEdges());
@@ -110,7 +135,7 @@ public:
     }
 
     const wcp::DataStructures::Cabletypes& Cabletypes() const {
-        return cabletypes_;
+        return *topology_->cabletypes;
     }
 
     bool IsTurbine(vertexID index) const {
@@ -138,57 +163,64 @@ protected:
     }
 
     void AddTurbine(vertexID index) {
-        turbineIdentifiers_.push_back(index);
-        ++numberOfTurbines_;
+        MutableTopology().turbineIdentifiers.push_back(index);
+        ++MutableTopology().numberOfTurbines;
     }
 
     void AddSubstation(vertexID index) {
-        substationIdentifiers_.push_back(index);
-        ++numberOfSubstations_;
+        MutableTopology().substationIdentifiers.push_back(index);
+        ++MutableTopology().numberOfSubstations;
     }
 
-    Vertex& VertexAt(vertexID index) {
+    const Vertex& VertexAt(vertexID index) const {
         assert(index >= 0);
         assert(index < NumberOfVertices());
-        return listOfVertices_[index];
+        return topology_->listOfVertices[index];
     }
 
-    const Vertex& VertexAt(vertexID index) const {
+    const Edge& EdgeAt(edgeID index) const {
         assert(index >= 0);
-        assert(index < NumberOfVertices());
-        return listOfVertices_[index];
+        assert(index <= NumberOfEdges());
+        return topology_->listOfEdges[index];
     }
 
-    Edge& EdgeAt(edgeID index) {
+    /**
+     * Write access to the topology, which is copied first if other wind farms share it.
+     * Reads go through VertexAt and EdgeAt, which never copy.
+     */
+    WindfarmTopology& MutableTopology() {
+        if (topology_.use_count() > 1) {
+            topology_ = std::make_shared<WindfarmTopology>(*topology_);
+        }
+        return *topology_;
+    }
+
+    Vertex& MutableVertexAt(vertexID index) {
         assert(index >= 0);
-        assert(index <= NumberOfEdges());
-        return listOfEdges_[index];
+        assert(index < NumberOfVertices());
+        return MutableTopology().listOfVertices[index];
     }
 
-    const Edge& EdgeAt(edgeID index) const {
+    Edge& MutableEdgeAt(edgeID index) {
         assert(index >= 0);
         assert(index <= NumberOfEdges());
-        return listOfEdges_[index];
+        return MutableTopology().listOfEdges[index];
     }
 
     void InitializeEdges(size_t edgeCount) {
-        listOfEdges_.resize(edgeCount, Edge());
+        MutableTopology().listOfEdges.resize(edgeCount, Edge());
     }
 
-private:
-    int numberOfOriginalVertices_; // number of vertices as in gml-file
-    int numberOfOriginalEdges_; // number of edges as in gml-file
-    int numberOfTurbines_;
-    int numberOfSubstations_;
-
-    std::vector<Vertex>   listOfVertices_; // vector of original vertices with supersubstation as last entry
-
-    std::vector<Edge>     listOfEdges_; // vector of original edges and edges between substation and supersubstation
-
-    std::vector<vertexID> turbineIdentifiers_;
-    std::vector<vertexID> substationIdentifiers_;
+    /**
+     * Replaces all edges, e.g., after an original edge has been added or removed.
+     */
+    void ReplaceEdges(std::vector<Edge>&& edges, int numberOfOriginalEdges) {
+        MutableTopology().listOfEdges = std::move(edges);
+        MutableTopology().numberOfOriginalEdges = numberOfOriginalEdges;
+    }
 
-    const wcp::DataStructures::Cabletypes&   cabletypes_;
+private:
+    std::shared_ptr<WindfarmTopology> topology_;
 };
 
 } // namespace DataStructures
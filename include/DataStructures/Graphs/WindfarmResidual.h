@@ -2,7 +2,11 @@
 #define DATASTRUCTURES_GRAPHS_WINDFARMRESIDUAL
 
 #include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <limits>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include <ogdf/basic/basic.h>
@@ -12,6 +16,7 @@
 
 #include "Auxiliary/Constants.h"
 
+#include "DataStructures/Graphs/CompactTypes.h"
 #include "DataStructures/Graphs/Windfarm.h"
 #include "DataStructures/Graphs/Edges/Edge.h"
 #include "DataStructures/Graphs/Vertices/Vertex.h"
@@ -22,6 +27,16 @@ namespace wcp {
 
 namespace DataStructures {
 
+/**
+ * A single change of flow as recorded by WindfarmResidual. The slot refers to
+ * an original edge (0 to m-1) or an edge towards the supersubstation (m to m+#V_S-1).
+ */
+struct FlowChange {
+    int slot;
+    int previousFlow;
+    int newFlow;
+};
+
 /**
  * Struct representing the residual graph of a windfarm, which is used
  * during the negative cycle canceling algorithm.
@@ -51,6 +66,12 @@ public:
 
     void SetFlowOnEdge(edgeID index, int newFlow);
 
+    /**
+     * Sets the flow on all edges to zero, e.g., to run another algorithm on the same residual graph.
+     * The flow journal is committed, see CommitFlow().
+     */
+    void ClearFlow();
+
     void AddFlowOnEdge(edgeID index, int delta) {
         SetFlowOnEdge(index, FlowOnEdge(index) + delta);
     }
@@ -64,13 +85,35 @@ public:
     double ResidualCostOnEdge(edgeID index) const {
         assert(index >= 0);
         assert(index < NumberOfEdges());
+#ifdef WCP_COMPACT
+        // Auxiliary::DINFTY does not fit into a float, see SetResidualCostOnEdge
+        return std::isinf(residualCosts_[index]) ? Auxiliary::DINFTY : residualCosts_[index];
+#else
         return residualCosts_[index];
+#endif
     }
 
-    double& ResidualCostOnEdge(edgeID index) {
+    /**
+     * Bounds how much ResidualCostOnEdge may differ from the cost it was set to, since
+     * residual costs are rounded to StoredCost. It is 0 unless built with WCP_COMPACT.
+     */
+    double ResidualCostRoundingErrorOnEdge(edgeID index) const {
+#ifdef WCP_COMPACT
+        return std::abs(ResidualCostOnEdge(index)) * std::numeric_limits<StoredCost>::epsilon();
+#else
+        (void) index;
+        return 0;
+#endif
+    }
+
+    void SetResidualCostOnEdge(edgeID index, double cost) {
         assert(index >= 0);
         assert(index < NumberOfEdges());
-        return residualCosts_[index];
+#ifdef WCP_COMPACT
+        residualCosts_[index] = cost >= Auxiliary::DINFTY ? std::numeric_limits<StoredCost>::infinity() : cost;
+#else
+        residualCosts_[index] = cost;
+#endif
     }
 
     /**
@@ -82,6 +125,10 @@ public:
         return Cabletypes().CostOfFlow(FlowOnEdge(index)) * Length(index);
     }
 
+    /**
+     * Returns the cost of the flow on all original edges. It is maintained in SetFlowOnEdge,
+     * unless a flow exceeds the maximum capacity, in which case it is computed from scratch.
+     */
     double ComputeTotalCostOfFlow() const;
 
     /**
@@ -126,23 +173,209 @@ public:
     }
 
     /**
-     * Writes flow values as edge weights in ogdf graph.
+     * Returns how many original edges carry a given flow value. The entry at index
+     * flow + MaximumCapacity() corresponds to the flow value flow.
+     */
+    const std::vector<int>& FlowHistogram() const { return flowHistogram_; }
+
+    /**
+     * Returns the number of original edges whose flow exceeds the maximum capacity
+     * in absolute value. Such flows are not covered by FlowHistogram().
+     */
+    int NumberOfEdgesOutsideFlowHistogram() const { return numberOfEdgesOutsideFlowHistogram_; }
+
+    /**
+     * Returns a counter that increases with every change of flow.
+     */
+    std::uint64_t FlowVersion() const { return flowVersion_; }
+
+    /**
+     * Returns whether the change that led to the given flow version is still recorded.
+     * Only the most recent changes are kept.
+     */
+    bool IsFlowChangeRecorded(std::uint64_t version) const {
+        return version > 0 && version <= flowVersion_ && flowVersion_ - version < flowChangeLog_.size();
+    }
+
+    const FlowChange& FlowChangeAt(std::uint64_t version) const {
+        assert(IsFlowChangeRecorded(version));
+        return flowChangeLog_[version % flowChangeLog_.size()];
+    }
+
+    std::size_t MaximumNumberOfRecordedFlowChanges() const { return flowChangeLog_.size(); }
+
+    /**
+     * Flow journal: after MarkFlow(), every change of flow is recorded until CommitFlow(),
+     * so that RollbackFlow() restores the flow at a mark in time linear in the number of
+     * changes since. The journal gives up once it holds more changes than there are flow
+     * slots, since copying all flow values is then cheaper; marks then become invalid
+     * until the next CommitFlow().
+     */
+    std::size_t MarkFlow() {
+        isFlowJournalOpen_ = true;
+        return flowJournal_.size();
+    }
+
+    bool CanRollbackFlowTo(std::size_t mark) const {
+        return isFlowJournalOpen_ && !hasFlowJournalOverflowed_ && mark <= flowJournal_.size();
+    }
+
+    /**
+     * Undoes all changes of flow since mark, which stays valid.
+     */
+    void RollbackFlow(std::size_t mark);
+
+    /**
+     * Discards the journal and stops recording.
+     */
+    void CommitFlow() {
+        flowJournal_.clear();
+        isFlowJournalOpen_ = false;
+        hasFlowJournalOverflowed_ = false;
+    }
+
+    /**
+     * Returns the changes of flow recorded since MarkFlow(). Entry i is the change after mark i.
+     */
+    const std::vector<FlowChange>& FlowJournal() const { return flowJournal_; }
+
+    /**
+     * Returns the edge and its reverse edge whose flow is stored in the given slot.
+     * The first edge carries the flow of the slot, the second one its negation.
+     */
+    std::pair<edgeID, edgeID> EdgesOfFlowSlot(int slot) const {
+        assert(slot >= 0);
+        assert(slot < NumberOfOriginalEdges() + NumberOfSubstations());
+        edgeID edge = (slot < NumberOfOriginalEdges()) ? slot : slot + NumberOfOriginalEdges();
+        return std::make_pair(edge, ReverseEdgeIndex(edge));
+    }
+
+    /**
+     * Writes flow values as edge weights in the ogdf graph of the instance,
+     * which is built if necessary. The edges are labeled with their index in
+     * the input file.
      *
      * This method does not perform a sanity check whether the ogdf graph
      * is consistent with the wind farm residual graph, nor does it check
-     * whether edge label is an enabled attribute in the ogdf graph.
+     * whether edge label is an enabled attribute in the ogdf graph. It throws
+     * a string if the topology has been edited, see HasEditedTopology().
      */
-    void writeFlowToOGDF(ogdf::Graph& graph, ogdf::GraphAttributes& graphAttr);
+    void writeFlowToOGDF(Instance& instance);
+
+    /**
+     * Edits of the topology for incremental re-optimization. They patch the wind farm in
+     * place but do not repair the flow, see Algorithms::TopologyEditor for that. The instance
+     * the wind farm was constructed from is not changed, so after AddEdge or RemoveEdge the
+     * edge indices of the wind farm and of the instance no longer agree.
+     */
+    void MoveVertex(vertexID vertex, double x, double y);
+
+    /**
+     * Returns true once any of the edits below has been applied. The flow of an edited wind
+     * farm must not be output through the instance it was constructed from.
+     */
+    bool HasEditedTopology() const { return hasEditedTopology_; }
+
+    void SetSubstationCapacity(vertexID substation, int capacity);
+
+    /**
+     * Adds an original edge without flow and returns its index, which is the previous
+     * NumberOfOriginalEdges(). Reverse and supersubstation edges move up accordingly.
+     */
+    edgeID AddEdge(vertexID source, vertexID target);
+
+    /**
+     * Removes an original edge without flow. The last original edge takes over its index.
+     */
+    void RemoveEdge(edgeID edge);
 
 private:
-    std::vector<int>& FlowValues() { return flowValues_; }
+    /**
+     * Builds the original, reverse and supersubstation edges and the adjacency lists.
+     */
+    void ComputeEdges(const Instance& instance);
+
+    /**
+     * Takes the edges and adjacency lists from a binary instance instead of computing them.
+     */
+    void CopyEdges(const IO::BinaryInstance::MappedFile& residualGraph);
+
+    void SetFlowInSlot(int slot, int newFlow) {
+        int previousFlow = flowValues_[slot];
+        if (previousFlow == newFlow) { return; }
+        assert(newFlow >= std::numeric_limits<StoredFlow>::min());
+        assert(newFlow <= std::numeric_limits<StoredFlow>::max());
+
+        flowValues_[slot] = newFlow;
+        if (slot < NumberOfOriginalEdges()) {
+            UpdateFlowHistogram(previousFlow, newFlow);
+            UpdateTotalCostOfFlow(slot, previousFlow, newFlow);
+        }
+
+        ++flowVersion_;
+        flowChangeLog_[flowVersion_ % flowChangeLog_.size()] = FlowChange{slot, previousFlow, newFlow};
+
+        if (isFlowJournalOpen_ && !hasFlowJournalOverflowed_) {
+            if (flowJournal_.size() < flowValues_.size()) {
+                flowJournal_.push_back(FlowChange{slot, previousFlow, newFlow});
+            } else {
+                flowJournal_.clear();
+                hasFlowJournalOverflowed_ = true;
+            }
+        }
+    }
+
+    void UpdateFlowHistogram(int oldFlow, int newFlow) {
+        int maximumCapacity = Cabletypes().MaximumCapacity();
+        if (oldFlow < -maximumCapacity || oldFlow > maximumCapacity) {
+            --numberOfEdgesOutsideFlowHistogram_;
+        } else {
+            --flowHistogram_[oldFlow + maximumCapacity];
+        }
+        if (newFlow < -maximumCapacity || newFlow > maximumCapacity) {
+            ++numberOfEdgesOutsideFlowHistogram_;
+        } else {
+            ++flowHistogram_[newFlow + maximumCapacity];
+        }
+    }
+
+    /**
+     * Only costs of flows within the maximum capacity are summed up, since the others are infinite.
+     */
+    void UpdateTotalCostOfFlow(edgeID edge, int oldFlow, int newFlow) {
+        int maximumCapacity = Cabletypes().MaximumCapacity();
+        if (oldFlow >= -maximumCapacity && oldFlow <= maximumCapacity) {
+            totalCostOfFlow_ -= Cabletypes().CostOfFlow(oldFlow) * Length(edge);
+        }
+        if (newFlow >= -maximumCapacity && newFlow <= maximumCapacity) {
+            totalCostOfFlow_ += Cabletypes().CostOfFlow(newFlow) * Length(edge);
+        }
+        // Summing up from scratch now and then bounds the rounding errors at amortized constant cost
+        if (++numberOfCostUpdatesSinceSummation_ > 4 * NumberOfOriginalEdges()) {
+            SumUpTotalCostOfFlow();
+        }
+    }
+
+    void SumUpTotalCostOfFlow();
+
+    double EuclideanDistance(vertexID first, vertexID second) const {
+        return std::sqrt(std::pow(X(first) - X(second), 2) + std::pow(Y(first) - Y(second), 2));
+    }
+
+    /**
+     * Renumbers all edges after original edges have been added or removed. The entry of each
+     * current original edge in newIndexOfOriginalEdge is its new index or INVALID_EDGE if it is
+     * removed. Indices that no current edge maps to are left to the caller. The recorded flow
+     * changes and the flow journal are discarded, since their slots are no longer valid.
+     */
+    void RenumberOriginalEdges(const std::vector<edgeID>& newIndexOfOriginalEdge, int newNumberOfOriginalEdges);
 
     void AddOutgoingEdge(vertexID vertexIndex, edgeID edgeIndex) {
         assert(vertexIndex >= 0);
         assert(vertexIndex < NumberOfVertices());
         assert(edgeIndex >= 0);
         assert(edgeIndex < NumberOfEdges());
-        VertexAt(vertexIndex).OutgoingEdges().push_back(edgeIndex);
+        MutableVertexAt(vertexIndex).OutgoingEdges().push_back(edgeIndex);
     }
 
     /**
@@ -152,12 +385,39 @@ private:
      * i.e. entries 0 to m-1 correspond to entries 0 to m-1 in listOfEdges_ and entries m to m+#V_S-1 correspond
      * to entries 2m to 2m+#V_S-1.
      */
-    std::vector<int> flowValues_;
+    std::vector<StoredFlow> flowValues_;
 
     /**
      * Cost values for all edges in the windfarm, including reverse and supersubstation edges
      */
-    std::vector<double> residualCosts_;
+    std::vector<StoredCost> residualCosts_;
+
+    /**
+     * Number of original edges per flow value, see FlowHistogram(). It is maintained in SetFlowOnEdge.
+     */
+    std::vector<int> flowHistogram_;
+    int numberOfEdgesOutsideFlowHistogram_;
+
+    /**
+     * Cost of the flows within the maximum capacity, see ComputeTotalCostOfFlow().
+     */
+    double totalCostOfFlow_;
+    int numberOfCostUpdatesSinceSummation_;
+
+    /**
+     * Ring buffer of the most recent flow changes, see FlowChangeAt().
+     */
+    std::uint64_t flowVersion_;
+    std::vector<FlowChange> flowChangeLog_;
+
+    /**
+     * Changes of flow since MarkFlow(), see RollbackFlow().
+     */
+    bool isFlowJournalOpen_;
+    bool hasFlowJournalOverflowed_;
+    std::vector<FlowChange> flowJournal_;
+
+    bool hasEditedTopology_;
 };
 
 inline void AssertZeroFlow(const WindfarmResidual& windfarm) {
@@ -166,13 +426,20 @@ inline void AssertZeroFlow(const WindfarmResidual& windfarm) {
     }
 }
 
-inline void AssertFeasibleFlow(const WindfarmResidual& windfarm) {
+/**
+ * Returns a description of the first violated condition of a feasible flow,
+ * or an empty string if the flow in windfarm is feasible.
+ */
+inline std::string FeasibilityViolation(const WindfarmResidual& windfarm) {
     // Edge capacities
     for (edgeID edge = 0; edge < windfarm.NumberOfEdges(); ++edge) {
-        assert(windfarm.FlowOnEdge(edge) == -windfarm.FlowOnEdge(windfarm.ReverseEdgeIndex(edge)));
+        if (windfarm.FlowOnEdge(edge) != -windfarm.FlowOnEdge(windfarm.ReverseEdgeIndex(edge))) {
+            return "The flow on edge " + std::to_string(edge) + " is not antisymmetric.";
+        }
         if (!windfarm.IsSuperSubstation(windfarm.StartVertex(edge))
-                && !windfarm.IsSuperSubstation(windfarm.EndVertex(edge))) {
-            assert(windfarm.FlowOnEdge(edge) <= windfarm.Cabletypes().MaximumCapacity());
+                && !windfarm.IsSuperSubstation(windfarm.EndVertex(edge))
+                && windfarm.FlowOnEdge(edge) > windfarm.Cabletypes().MaximumCapacity()) {
+            return "The flow on edge " + std::to_string(edge) + " exceeds the maximum cable capacity.";
         }
     }
 
@@ -182,30 +449,43 @@ inline void AssertFeasibleFlow(const WindfarmResidual& windfarm) {
         for (edgeID edge : windfarm.OutgoingEdges(turbine)) {
             sumOfFlow += windfarm.FlowOnEdge(edge);
         }
-        assert(sumOfFlow == 1);
+        if (sumOfFlow != 1) {
+            return "Turbine " + std::to_string(turbine) + " does not send exactly one unit of flow.";
+        }
     }
 
     // Flow conservation at substations
     for (vertexID substation : windfarm.Substations()) {
+        const std::string name = "Substation " + std::to_string(substation);
         int sumOfFlow = 0;
         for (edgeID edge : windfarm.OutgoingEdges(substation)) {
             sumOfFlow += windfarm.FlowOnEdge(edge);
 
             vertexID endVertex = windfarm.EndVertex(edge);
             if (windfarm.IsTurbine(endVertex)) {
-                assert(windfarm.FlowOnEdge(edge) <= 0);
+                if (windfarm.FlowOnEdge(edge) > 0) { return name + " sends flow to a turbine."; }
             } else if (windfarm.IsSuperSubstation(endVertex)) {
-                assert(windfarm.FlowOnEdge(edge) >= 0);
-                assert(windfarm.FlowToSubstation(substation)
-                        == windfarm.FlowOnEdge(edge));
-            } else {
-                assert(windfarm.FlowOnEdge(edge) == 0);
+                if (windfarm.FlowOnEdge(edge) < 0
+                        || windfarm.FlowToSubstation(substation) != windfarm.FlowOnEdge(edge)) {
+                    return name + " has an inconsistent flow towards the supersubstation.";
+                }
+            } else if (windfarm.FlowOnEdge(edge) != 0) {
+                return name + " has flow on an edge to another substation.";
             }
         }
-        assert(sumOfFlow == 0);
-        assert(windfarm.FlowToSubstation(substation) >= 0);
-        assert(windfarm.FlowToSubstation(substation) <= windfarm.VertexCapacity(substation));
+        if (sumOfFlow != 0) { return name + " violates flow conservation."; }
+        if (windfarm.FlowToSubstation(substation) < 0
+                || windfarm.FlowToSubstation(substation) > windfarm.VertexCapacity(substation)) {
+            return name + " receives a negative flow or more flow than its capacity.";
+        }
     }
+
+    return "";
+}
+
+inline void AssertFeasibleFlow(const WindfarmResidual& windfarm) {
+    (void) windfarm;
+    assert(FeasibilityViolation(windfarm).empty());
 }
 
 } // namespace DataStructures
@@ -3,6 +3,8 @@
 
 #include <QString>
 
+#include "DataStructures/StrategyNames.h"
+
 namespace wcp {
 
 namespace DataStructures {
@@ -37,11 +39,74 @@ public:
     unsigned int weightEscapeFreeCables_;
     unsigned int weightEscapeBonbon_;
 
+    // Portfolio of strategy combinations run in parallel
+    bool isPortfolioSet_;
+    QString portfolio_;
+    unsigned int numberOfThreads_;
+
+    // Number of EscapingNCC chains with different seeds run in parallel
+    unsigned int numberOfChains_;
+
+    // Number of hops around canceled cycles searched before a global detection run; 0 disables local detection
+    unsigned int localSearchHops_;
+
+    // Number of spatial windows per axis for windowed NCC; 1 disables windows
+    unsigned int numberOfWindowsPerAxis_;
+
+    // Solve the cluster of each substation in parallel before the global NCC run
+    bool decomposeBySubstations_;
+
+    // Initial epsilon for epsilon scaling; 0 disables epsilon scaling
+    double initialEpsilon_;
+
+    // Streaming of improvements during the run; "-" streams to standard out
+    bool isIncumbentStreamSet_;
+    QString incumbentStreamFile_;
+    double incumbentStreamIntervalInMilliseconds_;
+    bool streamFlowChanges_;
+
+    // Batch mode: instances from a list file or directory, each solved with all combinations of the grid
+    bool isBatchSet_;
+    QString batchInput_;
+    bool isGridSet_;
+    QString grid_;
+
+    // Server mode: solve requests from standard in or, if a path is given, from a UNIX domain socket
+    bool isServerSet_;
+    QString serverSocket_;
+
+    // Read instances with ogdf::GraphIO instead of IO::GMLReader
+    bool useOGDFReader_;
+
+    // Order of the vertices after reading an instance: NONE, HILBERT or RCM
+    QString vertexOrder_;
+
+    // Write the instance in the binary instance format instead of solving it
+    bool isConvertSet_;
+    QString convertFile_;
+
+    // Start from a flow read from a file instead of an initialization strategy
+    bool isWarmStartSet_;
+    QString warmStartFile_;
+
+    // Checkpoints of EscapingNCC and resuming from them
+    bool isCheckpointSet_;
+    QString checkpointFile_;
+    double checkpointIntervalInSeconds_;
+    bool isResumeSet_;
+    QString resumeFile_;
+
     // Output Control
     bool verbose_;
     bool printSolution_;
     bool printSummary_;
     bool printDetails_;
+
+    StrategyNames Strategies() const {
+        return StrategyNames{ initialisationStrategy_.toStdString(),
+                              deltaStrategy_.toStdString(),
+                              detectionStrategy_.toStdString() };
+    }
 };
 
 } // namespace DataStructures
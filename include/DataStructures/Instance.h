@@ -1,8 +1,13 @@
 #ifndef DATASTRUCTURES_INSTANCE
 #define DATASTRUCTURES_INSTANCE
 
+#include <algorithm>
+#include <cassert>
+#include <istream>
+#include <memory>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include <ogdf/basic/Array.h>
 #include <ogdf/basic/NodeArray.h>
@@ -12,13 +17,35 @@
 #include "DataStructures/Graphs/Vertices/Vertex.h"
 #include "DataStructures/Cabletypes.h"
 
+#include "IO/BinaryInstance.h"
+
 namespace wcp {
 
 namespace DataStructures {
 
+/**
+ * A turbine or substation of an instance as the wind farms are built from it.
+ */
+struct InstanceVertex {
+    double x;
+    double y;
+    VertexType type;
+    int capacity;   ///< Only used for substations
+};
+
+struct InstanceEdge {
+    int source;
+    int target;
+};
+
 /**
  * This class describes an instance. It contains a graph and its attributes
  * as well as the testset number and the instance number and the cable types.
+ *
+ * The wind farms are built from the flat lists of vertices and edges. The OGDF
+ * graph is only filled if the instance is read with OGDF or a solution is
+ * written as GraphML, see BuildOGDFGraph(). The OGDF graph keeps the numbering
+ * of the input file even if the lists are renumbered, see Renumber().
  */
 class Instance {
 public:
@@ -89,12 +116,144 @@ public:
         return cabletypes_;
     }
 
+    /**
+     * Replaces the cable types; only valid before any wind farm is built from the instance.
+     */
+    void SetCableTypes(std::vector<int> vectorOfCapacities, std::vector<int> vectorOfCosts) {
+        cabletypes_ = Cabletypes(std::move(vectorOfCapacities), std::move(vectorOfCosts));
+    }
+
+    /**
+     * Returns the residual graph of a binary instance, or nullptr if the wind farms compute it.
+     */
+    const IO::BinaryInstance::MappedFile* PrecomputedResidualGraph() const {
+        return precomputedResidualGraph_.get();
+    }
+
+    void SetPrecomputedResidualGraph(std::shared_ptr<const IO::BinaryInstance::MappedFile> residualGraph) {
+        precomputedResidualGraph_ = std::move(residualGraph);
+    }
+
     int NumberOfNodes() const {
-        return graph_.numberOfNodes();
+        return vertices_.size();
     }
 
     int NumberOfEdges() const {
-        return graph_.numberOfEdges();
+        return edges_.size();
+    }
+
+    const std::vector<InstanceVertex>& Vertices() const {
+        return vertices_;
+    }
+
+    const std::vector<InstanceEdge>& Edges() const {
+        return edges_;
+    }
+
+    /**
+     * Appends a vertex; call UpdateMembers() after the last one.
+     */
+    void AddVertex(double x, double y, VertexType type, int capacity) {
+        vertices_.push_back(InstanceVertex{x, y, type, capacity});
+    }
+
+    void AddEdge(int source, int target) {
+        edges_.push_back(InstanceEdge{source, target});
+    }
+
+    /**
+     * Renumbers the vertices such that vertex v becomes newIndexOfVertex[v] and sorts the
+     * edges by their new endpoints, so that the wind farms built afterwards store nearby
+     * vertices and their edges close to each other. A precomputed residual graph is dropped,
+     * since it refers to the previous numbering.
+     */
+    void Renumber(const std::vector<int>& newIndexOfVertex) {
+        assert(newIndexOfVertex.size() == vertices_.size());
+
+        std::vector<InstanceVertex> vertices(vertices_.size());
+        std::vector<int> originalIndexOfVertex(vertices_.size());
+        for (std::size_t vertex = 0; vertex < vertices_.size(); ++vertex) {
+            vertices[newIndexOfVertex[vertex]] = vertices_[vertex];
+            originalIndexOfVertex[newIndexOfVertex[vertex]] = OriginalVertexIndex(vertex);
+        }
+
+        std::vector<InstanceEdge> renamedEdges;
+        renamedEdges.reserve(edges_.size());
+        for (const InstanceEdge& edge : edges_) {
+            renamedEdges.push_back(InstanceEdge{newIndexOfVertex[edge.source], newIndexOfVertex[edge.target]});
+        }
+        auto Key = [&renamedEdges](int edge) {
+            return std::make_pair(std::min(renamedEdges[edge].source, renamedEdges[edge].target),
+                                  std::max(renamedEdges[edge].source, renamedEdges[edge].target));
+        };
+        std::vector<int> order(edges_.size());
+        for (std::size_t edge = 0; edge < order.size(); ++edge) { order[edge] = edge; }
+        std::stable_sort(order.begin(), order.end(), [&Key](int first, int second) { return Key(first) < Key(second); });
+
+        std::vector<InstanceEdge> edges;
+        std::vector<int> originalIndexOfEdge;
+        edges.reserve(edges_.size());
+        originalIndexOfEdge.reserve(edges_.size());
+        for (int edge : order) {
+            edges.push_back(renamedEdges[edge]);
+            originalIndexOfEdge.push_back(OriginalEdgeIndex(edge));
+        }
+        edgeIndexOfOriginalEdge_.assign(edges_.size(), 0);
+        for (std::size_t edge = 0; edge < originalIndexOfEdge.size(); ++edge) {
+            edgeIndexOfOriginalEdge_[originalIndexOfEdge[edge]] = edge;
+        }
+
+        vertices_.swap(vertices);
+        edges_.swap(edges);
+        originalIndexOfVertex_.swap(originalIndexOfVertex);
+        originalIndexOfEdge_.swap(originalIndexOfEdge);
+        precomputedResidualGraph_.reset();
+    }
+
+    bool IsRenumbered() const { return !originalIndexOfEdge_.empty() || !originalIndexOfVertex_.empty(); }
+
+    /**
+     * Returns the index in the input file of a vertex or edge, see Renumber().
+     */
+    int OriginalVertexIndex(int vertex) const {
+        return originalIndexOfVertex_.empty() ? vertex : originalIndexOfVertex_[vertex];
+    }
+
+    int OriginalEdgeIndex(int edge) const {
+        return originalIndexOfEdge_.empty() ? edge : originalIndexOfEdge_[edge];
+    }
+
+    /**
+     * Returns the current index of the edge with the given index in the input file.
+     */
+    int EdgeIndexOfOriginalEdge(int originalEdge) const {
+        return edgeIndexOfOriginalEdge_.empty() ? originalEdge : edgeIndexOfOriginalEdge_[originalEdge];
+    }
+
+    /**
+     * Reorders values given per edge in the numbering of the input file into the current numbering.
+     */
+    template<typename T>
+    std::vector<T> FromOriginalEdgeOrder(const std::vector<T>& valuesOfOriginalEdges) const {
+        if (!IsRenumbered() || valuesOfOriginalEdges.size() != edges_.size()) { return valuesOfOriginalEdges; }
+        std::vector<T> values(valuesOfOriginalEdges.size());
+        for (std::size_t originalEdge = 0; originalEdge < values.size(); ++originalEdge) {
+            values[EdgeIndexOfOriginalEdge(originalEdge)] = valuesOfOriginalEdges[originalEdge];
+        }
+        return values;
+    }
+
+    /**
+     * Reorders values given per edge in the current numbering into the numbering of the input file.
+     */
+    template<typename T>
+    std::vector<T> ToOriginalEdgeOrder(const std::vector<T>& values) const {
+        if (!IsRenumbered()) { return values; }
+        std::vector<T> valuesOfOriginalEdges(values.size());
+        for (std::size_t edge = 0; edge < values.size(); ++edge) {
+            valuesOfOriginalEdges[OriginalEdgeIndex(edge)] = values[edge];
+        }
+        return valuesOfOriginalEdges;
     }
 
     bool IsTurbine(ogdf::node node) const {
@@ -118,13 +277,54 @@ public:
 
     double SubstationCapacityTightness() const { return substationCapacityTightness_; }
 
-    void ReadFromGMLFile(const std::string& pathToInputFile) {
+    /**
+     * Reads the instance with OGDF. IO::ReadInstanceFromGMLFile reads it without building an OGDF graph.
+     */
+    void ReadFromGMLFileWithOGDF(const std::string& pathToInputFile) {
         ogdf::GraphIO::read(GraphAttributes(),
                             Graph(),
                             pathToInputFile,
                             ogdf::GraphIO::readGML);
-        UpdateMembers();
-        EnsurePrerequisites();
+        CopyFromOGDFGraph();
+    }
+
+    void ReadFromGMLStreamWithOGDF(std::istream& input) {
+        ogdf::GraphIO::read(GraphAttributes(),
+                            Graph(),
+                            input,
+                            ogdf::GraphIO::readGML);
+        CopyFromOGDFGraph();
+    }
+
+    /**
+     * Fills the OGDF graph from the vertices and edges unless it is filled already.
+     * Its nodes and edges are indexed as in the input file.
+     */
+    void BuildOGDFGraph() {
+        if (graph_.numberOfNodes() > 0) { return; }
+
+        std::vector<int> vertexIndexOfOriginalVertex(vertices_.size());
+        for (std::size_t vertex = 0; vertex < vertices_.size(); ++vertex) {
+            vertexIndexOfOriginalVertex[OriginalVertexIndex(vertex)] = vertex;
+        }
+
+        std::vector<ogdf::node> nodes(vertices_.size());
+        for (std::size_t originalVertex = 0; originalVertex < vertices_.size(); ++originalVertex) {
+            const int vertexIndex = vertexIndexOfOriginalVertex[originalVertex];
+            const InstanceVertex& vertex = vertices_[vertexIndex];
+            ogdf::node node = graph_.newNode();
+            graphAttributes_.x(node) = vertex.x;
+            graphAttributes_.y(node) = vertex.y;
+            graphAttributes_.shape(node) = static_cast<ogdf::Shape>(vertex.type);
+            if (vertex.type == VertexType::substation) {
+                graphAttributes_.label(node) = std::to_string(vertex.capacity);
+            }
+            nodes[vertexIndex] = node;
+        }
+        for (std::size_t originalEdge = 0; originalEdge < edges_.size(); ++originalEdge) {
+            const InstanceEdge& edge = edges_[EdgeIndexOfOriginalEdge(originalEdge)];
+            graph_.newEdge(nodes[edge.source], nodes[edge.target]);
+        }
     }
 
     void UpdateMembers() {
@@ -132,18 +332,12 @@ public:
         numberOfSubstations_ = 0;
         totalSubstationCapacity_ = 0;
 
-        for (ogdf::node v : graph_.nodes) {
-            try {
-                if (IsTurbine(v)) {
-                    ++numberOfTurbines_;
-                } else if (IsSubstation(v)) {
-                    ++numberOfSubstations_;
-                    totalSubstationCapacity_ += SubstationCapacity(v);
-                } else {
-                    throw v->index();
-                }
-            } catch (int i) {
-                throw "Could not identify type of ogdf-node " + std::to_string(i) + '\n';
+        for (const InstanceVertex& vertex : vertices_) {
+            if (vertex.type == VertexType::turbine) {
+                ++numberOfTurbines_;
+            } else {
+                ++numberOfSubstations_;
+                totalSubstationCapacity_ += vertex.capacity;
             }
         }
 
@@ -154,13 +348,11 @@ public:
         if (NumberOfNodes() == 0) {
             throw std::string("Input file is empty or does not exist.");
         }
-        if (Graph().maxNodeIndex() != Graph().numberOfNodes() - 1) {
-            throw "The vertex indices are not in the range from 0 to n-1 (="
-                    + std::to_string(Graph().numberOfNodes() - 1) + ")";
-        }
-        if (Graph().maxEdgeIndex() != Graph().numberOfEdges() - 1) {
-            throw "The edge indices are not in the range from 0 to n-1 (="
-                    + std::to_string(Graph().numberOfNodes() - 1) + ")";
+        for (std::size_t edge = 0; edge < edges_.size(); ++edge) {
+            if (edges_[edge].source < 0 || edges_[edge].source >= NumberOfNodes()
+                    || edges_[edge].target < 0 || edges_[edge].target >= NumberOfNodes()) {
+                throw "Edge " + std::to_string(edge) + " has an endpoint that is not a vertex.";
+            }
         }
     }
 
@@ -170,10 +362,7 @@ public:
      * with a reason why the graphs are not indexed identically.
      */
     std::pair<bool, std::string> GraphIsSimilarTo(const Instance& otherInstance) {
-        bool equalGraphs = true;
-
         if (NumberOfNodes() != otherInstance.NumberOfNodes()) {
-            std::cout << NumberOfNodes() << " " << otherInstance.NumberOfNodes() << std::endl;
             return std::make_pair(false, "Graphs do not have the same number of nodes.");
         }
 
@@ -181,29 +370,56 @@ public:
             return std::make_pair(false, "Graphs do not have the same number of edges.");
         }
 
-        if (Graph().maxNodeIndex() != otherInstance.Graph().maxNodeIndex()) {
-            return std::make_pair(false, "Max Node IDs do not match.");
+        for (std::size_t edge = 0; edge < edges_.size(); ++edge) {
+            if (edges_[edge].source != otherInstance.Edges()[edge].source
+                    || edges_[edge].target != otherInstance.Edges()[edge].target) {
+                return std::make_pair(false, "Vertices at edge " + std::to_string(edge) + " do not match.");
+            }
         }
+        return std::make_pair(true, "");
+    }
 
-        if (Graph().maxEdgeIndex() != otherInstance.Graph().maxEdgeIndex()) {
-            return std::make_pair(false, "Max Edge IDs do not match.");
+private:
+    /**
+     * Takes the vertices and edges from the OGDF graph after reading it.
+     */
+    void CopyFromOGDFGraph() {
+        if (graph_.numberOfNodes() == 0) {
+            throw std::string("Input file is empty or does not exist.");
+        }
+        if (graph_.maxNodeIndex() != graph_.numberOfNodes() - 1) {
+            throw "The vertex indices are not in the range from 0 to n-1 (="
+                    + std::to_string(graph_.numberOfNodes() - 1) + ")";
+        }
+        if (graph_.maxEdgeIndex() != graph_.numberOfEdges() - 1) {
+            throw "The edge indices are not in the range from 0 to n-1 (="
+                    + std::to_string(graph_.numberOfNodes() - 1) + ")";
         }
 
-        auto runningEdgeSecondInstance = otherInstance.Graph().firstEdge();
-        for (ogdf::edge e = graph_.firstEdge(); e; e = e->succ()) {
-            equalGraphs &= (e->source()->index() == runningEdgeSecondInstance->source()->index());
-            equalGraphs &= (e->target()->index() == runningEdgeSecondInstance->target()->index());
-            if (!equalGraphs) {
-                return std::make_pair(equalGraphs, "Vertices at edge " + std::to_string(e->index()) + " do not match.");
+        vertices_.assign(graph_.numberOfNodes(), InstanceVertex{0, 0, VertexType::turbine, 0});
+        for (ogdf::node v : graph_.nodes) {
+            InstanceVertex& vertex = vertices_[v->index()];
+            vertex.x = graphAttributes_.x(v);
+            vertex.y = graphAttributes_.y(v);
+            if (IsTurbine(v)) {
+                vertex.type = VertexType::turbine;
+            } else if (IsSubstation(v)) {
+                vertex.type = VertexType::substation;
+                vertex.capacity = SubstationCapacity(v);
+            } else {
+                throw "Could not identify type of ogdf-node " + std::to_string(v->index()) + '\n';
             }
-            runningEdgeSecondInstance = runningEdgeSecondInstance->succ();
         }
 
-        assert(equalGraphs);
-        return std::make_pair(equalGraphs, "");
+        edges_.assign(graph_.numberOfEdges(), InstanceEdge{0, 0});
+        for (ogdf::edge e : graph_.edges) {
+            edges_[e->index()] = InstanceEdge{e->source()->index(), e->target()->index()};
+        }
+
+        UpdateMembers();
+        EnsurePrerequisites();
     }
 
-private:
     ogdf::Graph graph_;
     ogdf::GraphAttributes graphAttributes_;
     int testsetNumber_;
@@ -211,6 +427,16 @@ private:
 
     Cabletypes cabletypes_;
 
+    std::vector<InstanceVertex> vertices_;
+    std::vector<InstanceEdge> edges_;
+
+    // Indices in the input file after Renumber(); empty if not renumbered
+    std::vector<int> originalIndexOfVertex_;
+    std::vector<int> originalIndexOfEdge_;
+    std::vector<int> edgeIndexOfOriginalEdge_;
+
+    std::shared_ptr<const IO::BinaryInstance::MappedFile> precomputedResidualGraph_;
+
     int numberOfTurbines_;
     int numberOfSubstations_;
 
@@ -17,8 +17,8 @@ class TwoDistancesLabel {
 public:
     TwoDistancesLabel()
       : dist_(Auxiliary::DINFTY),
-        parent_(INVALID_VERTEX),
         distSecond_(Auxiliary::DINFTY),
+        parent_(INVALID_VERTEX),
         parentSecond_(INVALID_VERTEX) {}
 
     /**
@@ -87,9 +87,10 @@ public:
     }
 
 private:
+    // The distances come first, so that the label takes 24 instead of 32 bytes.
     double dist_;
-    edgeID parent_;
     double distSecond_;
+    edgeID parent_;
     edgeID parentSecond_;
 };
 
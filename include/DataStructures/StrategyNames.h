@@ -0,0 +1,27 @@
+#ifndef DATASTRUCTURES_STRATEGYNAMES
+#define DATASTRUCTURES_STRATEGYNAMES
+
+#include <string>
+
+namespace wcp {
+
+namespace DataStructures {
+
+/**
+ * Names of the strategies of a run as they appear in summaries and file names.
+ */
+struct StrategyNames {
+    std::string initialization;
+    std::string delta;
+    std::string detection;
+
+    std::string Joined() const {
+        return initialization + "-" + delta + "-" + detection;
+    }
+};
+
+} // namespace DataStructures
+
+} // namespace wcp
+
+#endif
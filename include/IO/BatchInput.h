@@ -0,0 +1,54 @@
+#ifndef IO_BATCHINPUT
+#define IO_BATCHINPUT
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <QDir>
+#include <QFileInfo>
+#include <QString>
+#include <QStringList>
+
+namespace wcp {
+
+namespace IO {
+
+/**
+ * Returns the instance files for batch mode. If listOrDirectory is a directory,
+ * these are all .gml and .wcpi files in it in alphabetical order. Otherwise, it is a file
+ * with one path per line, where empty lines and lines starting with '#' are skipped.
+ */
+inline std::vector<std::string> ListInstanceFiles(const QString& listOrDirectory) {
+    std::vector<std::string> instanceFiles;
+
+    QFileInfo info(listOrDirectory);
+    if (info.isDir()) {
+        QDir directory(listOrDirectory);
+        for (const QString& fileName : directory.entryList(QStringList() << "*.gml" << "*.wcpi", QDir::Files, QDir::Name)) {
+            instanceFiles.push_back(directory.filePath(fileName).toStdString());
+        }
+    } else {
+        std::ifstream listFile(listOrDirectory.toStdString());
+        if (!listFile.is_open()) {
+            throw "Could not open the batch input '" + listOrDirectory.toStdString() + "'.";
+        }
+        std::string line;
+        while (std::getline(listFile, line)) {
+            QString path = QString::fromStdString(line).trimmed();
+            if (path.isEmpty() || path.startsWith("#")) { continue; }
+            instanceFiles.push_back(path.toStdString());
+        }
+    }
+
+    if (instanceFiles.empty()) {
+        throw "The batch input '" + listOrDirectory.toStdString() + "' does not contain any instance.";
+    }
+    return instanceFiles;
+}
+
+} // namespace IO
+
+} // namespace wcp
+
+#endif
@@ -0,0 +1,213 @@
+#ifndef IO_BINARYINSTANCE
+#define IO_BINARYINSTANCE
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace wcp {
+
+namespace IO {
+
+/**
+ * A versioned binary instance format that holds the final arrays of the residual
+ * graph, so that a wind farm is built without computing lengths or adjacency lists.
+ * The file is mapped read-only, so that processes working on the same file share
+ * its pages. All numbers are stored in the byte order of the machine that wrote
+ * the file; a file of the other byte order is rejected.
+ *
+ * After the header follow these sections, each starting at a multiple of 8 bytes,
+ * with n original vertices, E residual edges and c cable types:
+ *      vertexX, vertexY            double[n]
+ *      vertexType, vertexCapacity  int32[n]
+ *      cableCapacities, cableCosts int32[c]
+ *      edgeStart, edgeEnd          int32[E]
+ *      edgeCapacity                int32[E]
+ *      edgeLength                  double[E]
+ *      adjacencyOffsets            int64[n + 2]    (the supersubstation is vertex n)
+ *      adjacency                   int32[E]        (outgoing edges in CSR form)
+ * The residual edges are ordered as in DataStructures::WindfarmResidual.
+ */
+namespace BinaryInstance {
+
+const char MAGIC[8] = {'W', 'C', 'P', 'I', 'N', 'S', 'T', '\0'};
+const std::uint32_t VERSION = 1;
+const std::uint32_t BYTE_ORDER_MARK = 0x01020304;
+
+struct Header {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t byteOrderMark;
+    std::int64_t numberOfVertices;          ///< Original vertices, without the supersubstation
+    std::int64_t numberOfOriginalEdges;
+    std::int64_t numberOfResidualEdges;
+    std::int64_t numberOfCables;
+};
+
+/**
+ * Byte offsets of the sections in a file with the numbers of header.
+ */
+struct Layout {
+    Layout(const Header& header) {
+        const std::size_t n = header.numberOfVertices;
+        const std::size_t m = header.numberOfResidualEdges;
+        const std::size_t c = header.numberOfCables;
+
+        std::size_t offset = Aligned(sizeof(Header));
+        auto Next = [&offset](std::size_t bytes) {
+            std::size_t section = offset;
+            offset = Aligned(offset + bytes);
+            return section;
+        };
+        vertexX             = Next(n * sizeof(double));
+        vertexY             = Next(n * sizeof(double));
+        vertexType          = Next(n * sizeof(std::int32_t));
+        vertexCapacity      = Next(n * sizeof(std::int32_t));
+        cableCapacities     = Next(c * sizeof(std::int32_t));
+        cableCosts          = Next(c * sizeof(std::int32_t));
+        edgeStart           = Next(m * sizeof(std::int32_t));
+        edgeEnd             = Next(m * sizeof(std::int32_t));
+        edgeCapacity        = Next(m * sizeof(std::int32_t));
+        edgeLength          = Next(m * sizeof(double));
+        adjacencyOffsets    = Next((n + 2) * sizeof(std::int64_t));
+        adjacency           = Next(m * sizeof(std::int32_t));
+        size                = offset;
+    }
+
+    static std::size_t Aligned(std::size_t offset) {
+        return (offset + 7) / 8 * 8;
+    }
+
+    std::size_t vertexX;
+    std::size_t vertexY;
+    std::size_t vertexType;
+    std::size_t vertexCapacity;
+    std::size_t cableCapacities;
+    std::size_t cableCosts;
+    std::size_t edgeStart;
+    std::size_t edgeEnd;
+    std::size_t edgeCapacity;
+    std::size_t edgeLength;
+    std::size_t adjacencyOffsets;
+    std::size_t adjacency;
+    std::size_t size;
+};
+
+inline bool IsBinaryInstance(const std::string& fileName) {
+    int fileDescriptor = open(fileName.c_str(), O_RDONLY);
+    if (fileDescriptor < 0) { return false; }
+    char magic[sizeof(MAGIC)];
+    bool isBinary = read(fileDescriptor, magic, sizeof(magic)) == static_cast<ssize_t>(sizeof(magic))
+                        && std::equal(magic, magic + sizeof(magic), MAGIC);
+    close(fileDescriptor);
+    return isBinary;
+}
+
+/**
+ * A binary instance file mapped into memory. Opening it only checks the header
+ * and the size of the file; the sections are read on access and validated by
+ * DataStructures::WindfarmResidual::CopyEdges before they are used.
+ */
+class MappedFile {
+public:
+    /**
+     * Throws a string if the file cannot be mapped or is not a binary instance of this version.
+     */
+    MappedFile(const std::string& fileName)
+      : data_(nullptr),
+        size_(0),
+        layout_(Header()) {
+        int fileDescriptor = open(fileName.c_str(), O_RDONLY);
+        if (fileDescriptor < 0) {
+            throw "Could not open the binary instance '" + fileName + "'.";
+        }
+        struct stat status;
+        if (fstat(fileDescriptor, &status) != 0 || static_cast<std::size_t>(status.st_size) < sizeof(Header)) {
+            close(fileDescriptor);
+            throw "The binary instance '" + fileName + "' is truncated.";
+        }
+        size_ = status.st_size;
+        void* data = mmap(nullptr, size_, PROT_READ, MAP_SHARED, fileDescriptor, 0);
+        close(fileDescriptor);
+        if (data == MAP_FAILED) {
+            throw "Could not map the binary instance '" + fileName + "' into memory.";
+        }
+        data_ = static_cast<const char*>(data);
+
+        const Header& header = GetHeader();
+        if (!std::equal(header.magic, header.magic + sizeof(MAGIC), MAGIC)) {
+            Unmap();
+            throw "The file '" + fileName + "' is not a binary instance.";
+        }
+        if (header.byteOrderMark != BYTE_ORDER_MARK) {
+            Unmap();
+            throw "The binary instance '" + fileName + "' was written on a machine with a different byte order.";
+        }
+        if (header.version != VERSION) {
+            Unmap();
+            throw "The binary instance '" + fileName + "' has version " + std::to_string(header.version)
+                    + ", but version " + std::to_string(VERSION) + " is expected. Convert the instance again.";
+        }
+        if (header.numberOfVertices < 0 || header.numberOfOriginalEdges < 0
+                || header.numberOfResidualEdges < 2 * header.numberOfOriginalEdges || header.numberOfCables <= 0) {
+            Unmap();
+            throw "The header of the binary instance '" + fileName + "' is corrupt.";
+        }
+        layout_ = Layout(header);
+        if (layout_.size != size_) {
+            Unmap();
+            throw "The binary instance '" + fileName + "' has the wrong size.";
+        }
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    void operator=(const MappedFile&) = delete;
+
+    ~MappedFile() { Unmap(); }
+
+    const Header& GetHeader() const { return *reinterpret_cast<const Header*>(data_); }
+
+    const double*       VertexX()           const { return Section<double>(layout_.vertexX); }
+    const double*       VertexY()           const { return Section<double>(layout_.vertexY); }
+    const std::int32_t* VertexType()        const { return Section<std::int32_t>(layout_.vertexType); }
+    const std::int32_t* VertexCapacity()    const { return Section<std::int32_t>(layout_.vertexCapacity); }
+    const std::int32_t* CableCapacities()   const { return Section<std::int32_t>(layout_.cableCapacities); }
+    const std::int32_t* CableCosts()        const { return Section<std::int32_t>(layout_.cableCosts); }
+    const std::int32_t* EdgeStart()         const { return Section<std::int32_t>(layout_.edgeStart); }
+    const std::int32_t* EdgeEnd()           const { return Section<std::int32_t>(layout_.edgeEnd); }
+    const std::int32_t* EdgeCapacity()      const { return Section<std::int32_t>(layout_.edgeCapacity); }
+    const double*       EdgeLength()        const { return Section<double>(layout_.edgeLength); }
+    const std::int64_t* AdjacencyOffsets()  const { return Section<std::int64_t>(layout_.adjacencyOffsets); }
+    const std::int32_t* Adjacency()         const { return Section<std::int32_t>(layout_.adjacency); }
+
+private:
+    template<typename T>
+    const T* Section(std::size_t offset) const {
+        return reinterpret_cast<const T*>(data_ + offset);
+    }
+
+    void Unmap() {
+        if (data_ != nullptr) {
+            munmap(const_cast<char*>(data_), size_);
+            data_ = nullptr;
+        }
+    }
+
+    const char* data_;
+    std::size_t size_;
+    Layout layout_;
+};
+
+} // namespace BinaryInstance
+
+} // namespace IO
+
+} // namespace wcp
+
+#endif
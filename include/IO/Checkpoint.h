@@ -0,0 +1,253 @@
+#ifndef IO_CHECKPOINT
+#define IO_CHECKPOINT
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "DataStructures/Graphs/Windfarm.h" // for edgeID
+
+namespace wcp {
+
+namespace IO {
+
+/**
+ * The state of an EscapingNCC run between two iterations, from which the run
+ * can be resumed deterministically.
+ */
+struct EscapingCheckpoint {
+    /**
+     * Flow on each original edge, followed by the flow into each substation.
+     */
+    std::vector<int> flowInSlots;
+
+    /**
+     * Best flow found so far on all edges of the residual graph.
+     */
+    std::vector<int> bestFlow;
+    double bestSolutionValue = 0;
+    double solutionCosts = 0;
+    unsigned int runs = 0;
+
+    int bonbonChangeOfFlow = -1;
+    edgeID bonbonEdge = -1;
+
+    /**
+     * Edges with special residual costs from escaping together with their expanded cost vectors.
+     */
+    std::vector<std::pair<edgeID, std::vector<int>>> adaptedResidualCosts;
+
+    /**
+     * Vertices of the most recently canceled cycles and the current region for local detection.
+     */
+    std::vector<int> verticesOnCanceledCycles;
+    std::vector<int> localDetectionRegion;
+
+    /**
+     * Opaque states of the escaping strategies and of the delta strategy, e.g., their random number generators.
+     */
+    std::string stateOfEscapingStrategies;
+    std::string stateOfDeltaStrategy;
+};
+
+namespace CheckpointFormat {
+
+const char MAGIC[8] = {'W', 'C', 'P', 'C', 'K', 'P', 'T', '\0'};
+const std::uint32_t VERSION = 1;
+
+template<typename T>
+inline void WriteValue(std::ostream& os, const T& value) {
+    os.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template<typename T>
+inline T ReadValue(std::istream& is) {
+    T value;
+    if (!is.read(reinterpret_cast<char*>(&value), sizeof(T))) {
+        throw std::string("The checkpoint is truncated.");
+    }
+    return value;
+}
+
+inline void WriteIntVector(std::ostream& os, const std::vector<int>& values) {
+    WriteValue<std::uint64_t>(os, values.size());
+    os.write(reinterpret_cast<const char*>(values.data()), values.size() * sizeof(int));
+}
+
+inline std::vector<int> ReadIntVector(std::istream& is) {
+    std::vector<int> values(ReadValue<std::uint64_t>(is));
+    if (!is.read(reinterpret_cast<char*>(values.data()), values.size() * sizeof(int))) {
+        throw std::string("The checkpoint is truncated.");
+    }
+    return values;
+}
+
+inline void WriteString(std::ostream& os, const std::string& text) {
+    WriteValue<std::uint64_t>(os, text.size());
+    os.write(text.data(), text.size());
+}
+
+inline std::string ReadString(std::istream& is) {
+    std::string text(ReadValue<std::uint64_t>(is), '\0');
+    if (!is.read(&text[0], text.size())) {
+        throw std::string("The checkpoint is truncated.");
+    }
+    return text;
+}
+
+} // namespace CheckpointFormat
+
+/**
+ * Writes the checkpoint to a temporary file first and then renames it, so
+ * that an interrupted write never destroys the previous checkpoint.
+ * Returns false if the file could not be written.
+ */
+inline bool WriteCheckpoint(const std::string& fileName, const EscapingCheckpoint& checkpoint) {
+    using namespace CheckpointFormat;
+
+    const std::string temporaryFileName = fileName + ".tmp";
+    {
+        std::ofstream os(temporaryFileName, std::ios::binary | std::ios::trunc);
+        if (!os.is_open()) { return false; }
+
+        os.write(MAGIC, sizeof(MAGIC));
+        WriteValue(os, VERSION);
+        WriteIntVector(os, checkpoint.flowInSlots);
+        WriteIntVector(os, checkpoint.bestFlow);
+        WriteValue(os, checkpoint.bestSolutionValue);
+        WriteValue(os, checkpoint.solutionCosts);
+        WriteValue<std::uint32_t>(os, checkpoint.runs);
+        WriteValue<std::int32_t>(os, checkpoint.bonbonChangeOfFlow);
+        WriteValue<std::int32_t>(os, checkpoint.bonbonEdge);
+        WriteValue<std::uint64_t>(os, checkpoint.adaptedResidualCosts.size());
+        for (auto&& adaptedCost : checkpoint.adaptedResidualCosts) {
+            WriteValue<std::int32_t>(os, adaptedCost.first);
+            WriteIntVector(os, adaptedCost.second);
+        }
+        WriteIntVector(os, checkpoint.verticesOnCanceledCycles);
+        WriteIntVector(os, checkpoint.localDetectionRegion);
+        WriteString(os, checkpoint.stateOfEscapingStrategies);
+        WriteString(os, checkpoint.stateOfDeltaStrategy);
+
+        os.flush();
+        if (!os) { return false; }
+    }
+    return std::rename(temporaryFileName.c_str(), fileName.c_str()) == 0;
+}
+
+/**
+ * Reads a checkpoint written by WriteCheckpoint. Throws a string if the file
+ * cannot be read or is not a checkpoint.
+ */
+inline EscapingCheckpoint ReadCheckpoint(const std::string& fileName) {
+    using namespace CheckpointFormat;
+
+    std::ifstream is(fileName, std::ios::binary);
+    if (!is.is_open()) {
+        throw "Could not open checkpoint '" + fileName + "'.";
+    }
+
+    try {
+        char magic[sizeof(MAGIC)];
+        if (!is.read(magic, sizeof(magic)) || !std::equal(magic, magic + sizeof(magic), MAGIC)) {
+            throw std::string("The file is not a checkpoint.");
+        }
+        if (ReadValue<std::uint32_t>(is) != VERSION) {
+            throw std::string("The checkpoint has an unsupported version.");
+        }
+
+        EscapingCheckpoint checkpoint;
+        checkpoint.flowInSlots          = ReadIntVector(is);
+        checkpoint.bestFlow             = ReadIntVector(is);
+        checkpoint.bestSolutionValue    = ReadValue<double>(is);
+        checkpoint.solutionCosts        = ReadValue<double>(is);
+        checkpoint.runs                 = ReadValue<std::uint32_t>(is);
+        checkpoint.bonbonChangeOfFlow   = ReadValue<std::int32_t>(is);
+        checkpoint.bonbonEdge           = ReadValue<std::int32_t>(is);
+        std::uint64_t numberOfAdaptedCosts = ReadValue<std::uint64_t>(is);
+        for (std::uint64_t i = 0; i < numberOfAdaptedCosts; ++i) {
+            edgeID edge = ReadValue<std::int32_t>(is);
+            checkpoint.adaptedResidualCosts.emplace_back(edge, ReadIntVector(is));
+        }
+        checkpoint.verticesOnCanceledCycles  = ReadIntVector(is);
+        checkpoint.localDetectionRegion      = ReadIntVector(is);
+        checkpoint.stateOfEscapingStrategies = ReadString(is);
+        checkpoint.stateOfDeltaStrategy      = ReadString(is);
+        return checkpoint;
+    } catch (const std::string& e) {
+        throw "Could not read checkpoint '" + fileName + "': " + e;
+    }
+}
+
+/**
+ * Writes checkpoints on a background thread, so that the algorithm only pays for
+ * copying its state. If a checkpoint is submitted while the previous one is still
+ * pending, the previous one is skipped. The destructor writes the pending checkpoint.
+ */
+class CheckpointWriter {
+public:
+    CheckpointWriter(std::string fileName)
+      : fileName_(std::move(fileName)),
+        isShuttingDown_(false),
+        worker_(&CheckpointWriter::WriteLoop, this) {}
+
+    CheckpointWriter(const CheckpointWriter&) = delete;
+    CheckpointWriter& operator=(const CheckpointWriter&) = delete;
+
+    ~CheckpointWriter() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            isShuttingDown_ = true;
+        }
+        hasWork_.notify_one();
+        worker_.join();
+    }
+
+    void Submit(EscapingCheckpoint&& checkpoint) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            pendingCheckpoint_ = std::make_unique<EscapingCheckpoint>(std::move(checkpoint));
+        }
+        hasWork_.notify_one();
+    }
+
+private:
+    void WriteLoop() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (true) {
+            hasWork_.wait(lock, [this] { return pendingCheckpoint_ != nullptr || isShuttingDown_; });
+            if (pendingCheckpoint_ == nullptr) { return; }
+
+            std::unique_ptr<EscapingCheckpoint> checkpoint = std::move(pendingCheckpoint_);
+            lock.unlock();
+            if (!WriteCheckpoint(fileName_, *checkpoint)) {
+                std::cerr << "Could not write checkpoint '" << fileName_ << "'.\n";
+            }
+            lock.lock();
+        }
+    }
+
+    std::string fileName_;
+
+    std::mutex mutex_;
+    std::condition_variable hasWork_;
+    std::unique_ptr<EscapingCheckpoint> pendingCheckpoint_;
+    bool isShuttingDown_;
+
+    std::thread worker_;
+};
+
+} // namespace IO
+
+} // namespace wcp
+
+#endif
@@ -0,0 +1,120 @@
+#ifndef IO_FLOWFILE
+#define IO_FLOWFILE
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <ogdf/basic/Graph.h>
+#include <ogdf/basic/GraphAttributes.h>
+#include <ogdf/fileformats/GraphIO.h>
+
+#include "Auxiliary/Constants.h"
+
+namespace wcp {
+
+namespace IO {
+
+/**
+ * Reading and writing the flow on the original edges of a wind farm, e.g., to
+ * start NCC from a previous solution. Two formats are supported: the GraphML
+ * files written with --print-solution, where the label of an edge holds its
+ * index and the double weight its flow, and a compact binary dump consisting
+ * of a magic string, the number of edges and one 32-bit flow value per edge.
+ */
+namespace FlowFile {
+
+const char MAGIC[8] = {'W', 'C', 'P', 'F', 'L', 'O', 'W', '\0'};
+
+inline void WriteBinary(const std::string& fileName, const std::vector<int>& flowOnOriginalEdges) {
+    std::ofstream os(fileName, std::ios::binary | std::ios::trunc);
+    if (!os.is_open()) {
+        throw "Could not open file '" + fileName + "' for writing the flow.";
+    }
+    std::uint64_t numberOfEdges = flowOnOriginalEdges.size();
+    os.write(MAGIC, sizeof(MAGIC));
+    os.write(reinterpret_cast<const char*>(&numberOfEdges), sizeof(numberOfEdges));
+    for (int flow : flowOnOriginalEdges) {
+        std::int32_t value = flow;
+        os.write(reinterpret_cast<const char*>(&value), sizeof(value));
+    }
+}
+
+inline bool IsBinary(const std::string& fileName) {
+    std::ifstream is(fileName, std::ios::binary);
+    char magic[sizeof(MAGIC)];
+    return is.read(magic, sizeof(magic)) && std::equal(magic, magic + sizeof(magic), MAGIC);
+}
+
+inline std::vector<int> ReadBinary(const std::string& fileName) {
+    std::ifstream is(fileName, std::ios::binary);
+    is.ignore(sizeof(MAGIC));
+
+    std::uint64_t numberOfEdges = 0;
+    if (!is.read(reinterpret_cast<char*>(&numberOfEdges), sizeof(numberOfEdges))) {
+        throw "The flow file '" + fileName + "' is truncated.";
+    }
+    std::vector<int> flowOnOriginalEdges;
+    for (std::uint64_t edge = 0; edge < numberOfEdges; ++edge) {
+        std::int32_t value;
+        if (!is.read(reinterpret_cast<char*>(&value), sizeof(value))) {
+            throw "The flow file '" + fileName + "' is truncated.";
+        }
+        flowOnOriginalEdges.push_back(value);
+    }
+    return flowOnOriginalEdges;
+}
+
+inline std::vector<int> ReadGraphML(const std::string& fileName) {
+    ogdf::Graph graph;
+    ogdf::GraphAttributes graphAttributes(graph, ogdf::GraphAttributes::edgeLabel | ogdf::GraphAttributes::edgeDoubleWeight);
+    if (!ogdf::GraphIO::read(graphAttributes, graph, fileName, ogdf::GraphIO::readGraphML)) {
+        throw "Could not read a flow from the GraphML file '" + fileName + "'.";
+    }
+
+    std::vector<int> flowOnOriginalEdges(graph.numberOfEdges(), 0);
+    std::vector<bool> hasFlow(graph.numberOfEdges(), false);
+    for (ogdf::edge e : graph.edges) {
+        // The label holds the index of the edge in the instance, see WindfarmResidual::writeFlowToOGDF
+        int index;
+        try {
+            index = graphAttributes.label(e).empty() ? e->index() : std::stoi(graphAttributes.label(e));
+        } catch (const std::exception&) {
+            throw "The flow file '" + fileName + "' contains an edge with label '" + graphAttributes.label(e) + "' that is no edge index.";
+        }
+        if (index < 0 || index >= graph.numberOfEdges() || hasFlow[index]) {
+            throw "The flow file '" + fileName + "' contains an invalid or duplicate edge index " + std::to_string(index) + ".";
+        }
+
+        double flow = graphAttributes.doubleWeight(e);
+        if (std::abs(flow - std::round(flow)) > Auxiliary::DOUBLE_ROUNDING_PRECISION) {
+            throw "The flow file '" + fileName + "' contains the non-integral flow " + std::to_string(flow) + ".";
+        }
+        flowOnOriginalEdges[index] = static_cast<int>(std::lround(flow));
+        hasFlow[index] = true;
+    }
+    return flowOnOriginalEdges;
+}
+
+/**
+ * Reads the flow on the original edges from fileName in either format.
+ * Throws a string if the file cannot be read.
+ */
+inline std::vector<int> Read(const std::string& fileName) {
+    if (!std::ifstream(fileName).good()) {
+        throw "Could not open the flow file '" + fileName + "'.";
+    }
+    return IsBinary(fileName) ? ReadBinary(fileName) : ReadGraphML(fileName);
+}
+
+} // namespace FlowFile
+
+} // namespace IO
+
+} // namespace wcp
+
+#endif
@@ -0,0 +1,346 @@
+#ifndef IO_GMLREADER
+#define IO_GMLREADER
+
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <istream>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "DataStructures/Graphs/Vertices/Vertex.h"
+#include "DataStructures/Instance.h"
+
+namespace wcp {
+
+namespace IO {
+
+/**
+ * Reads an instance in GML in a single pass over a buffered stream straight into
+ * the vertices and edges of a DataStructures::Instance, without building an OGDF
+ * graph. It reads what ogdf::GraphIO::readGML reads for the instances: the label
+ * of a node is the capacity of a substation, its graphics hold the coordinates and
+ * the shape ("rect" for turbines and "oval" for substations, turbine if missing),
+ * and the nodes and edges are indexed in the order in which they appear. Unknown
+ * keys are skipped.
+ */
+class GMLReader {
+public:
+    GMLReader(std::istream& input)
+      : input_(input),
+        buffer_(BUFFER_SIZE),
+        position_(0),
+        end_(0),
+        line_(1) {}
+
+    /**
+     * Throws a string if the input is not a valid instance.
+     */
+    void ReadInstance(DataStructures::Instance& instance) {
+        bool hasGraph = false;
+        for (Token token = NextToken(); token != Token::END; token = NextToken()) {
+            if (token != Token::KEY) { Fail("Expected a key"); }
+
+            if (text_ == "graph") {
+                ExpectListBegin("graph");
+                ReadGraph(instance);
+                hasGraph = true;
+            } else {
+                SkipValueOf(NextToken());
+            }
+        }
+        if (!hasGraph) {
+            throw std::string("Input file is empty or does not exist.");
+        }
+        instance.UpdateMembers();
+        instance.EnsurePrerequisites();
+    }
+
+private:
+    enum class Token {
+        KEY,
+        NUMBER,
+        STRING,
+        LIST_BEGIN,
+        LIST_END,
+        END
+    };
+
+    void ReadGraph(DataStructures::Instance& instance) {
+        std::unordered_map<long, int> indexOfNode;
+        // Edges may refer to nodes that appear later.
+        std::vector<std::pair<long, long>> edges;
+
+        for (Token token = NextToken(); token != Token::LIST_END; token = NextToken()) {
+            if (token != Token::KEY) { Fail("Expected a key in the graph"); }
+
+            if (text_ == "node") {
+                ExpectListBegin("node");
+                ReadNode(instance, indexOfNode);
+            } else if (text_ == "edge") {
+                ExpectListBegin("edge");
+                edges.push_back(ReadEdge());
+            } else {
+                SkipValueOf(NextToken());
+            }
+        }
+
+        for (const std::pair<long, long>& edge : edges) {
+            auto source = indexOfNode.find(edge.first);
+            auto target = indexOfNode.find(edge.second);
+            if (source == indexOfNode.end() || target == indexOfNode.end()) {
+                throw "An edge refers to the node " + std::to_string(source == indexOfNode.end() ? edge.first : edge.second)
+                        + ", which does not exist.";
+            }
+            instance.AddEdge(source->second, target->second);
+        }
+    }
+
+    void ReadNode(DataStructures::Instance& instance, std::unordered_map<long, int>& indexOfNode) {
+        bool hasId = false;
+        long id = 0;
+        double x = 0;
+        double y = 0;
+        DataStructures::VertexType type = DataStructures::VertexType::turbine;
+        std::string label;
+
+        for (Token token = NextToken(); token != Token::LIST_END; token = NextToken()) {
+            if (token != Token::KEY) { Fail("Expected a key in a node"); }
+
+            if (text_ == "id") {
+                id = ReadInteger("id");
+                hasId = true;
+            } else if (text_ == "label") {
+                Token value = NextToken();
+                if (value != Token::STRING && value != Token::NUMBER) { Fail("Expected the label of a node"); }
+                label = text_;
+            } else if (text_ == "graphics") {
+                ExpectListBegin("graphics");
+                ReadNodeGraphics(x, y, type);
+            } else {
+                SkipValueOf(NextToken());
+            }
+        }
+
+        if (!hasId) { Fail("A node has no id"); }
+        if (!indexOfNode.emplace(id, static_cast<int>(instance.NumberOfNodes())).second) {
+            Fail("The node id " + std::to_string(id) + " appears twice");
+        }
+
+        int capacity = 0;
+        if (type == DataStructures::VertexType::substation) {
+            char* endOfNumber = nullptr;
+            capacity = static_cast<int>(std::strtol(label.c_str(), &endOfNumber, 10));
+            if (label.empty() || *endOfNumber != '\0') {
+                throw "Could not read the capacity of substation " + std::to_string(id) + " from its label '" + label + "'.";
+            }
+        }
+        instance.AddVertex(x, y, type, capacity);
+    }
+
+    void ReadNodeGraphics(double& x, double& y, DataStructures::VertexType& type) {
+        for (Token token = NextToken(); token != Token::LIST_END; token = NextToken()) {
+            if (token != Token::KEY) { Fail("Expected a key in the graphics of a node"); }
+
+            if (text_ == "x") {
+                x = ReadNumber("x");
+            } else if (text_ == "y") {
+                y = ReadNumber("y");
+            } else if (text_ == "type" || text_ == "shape") {
+                if (NextToken() != Token::STRING) { Fail("Expected the shape of a node"); }
+                type = TypeOfShape(text_);
+            } else {
+                SkipValueOf(NextToken());
+            }
+        }
+    }
+
+    std::pair<long, long> ReadEdge() {
+        bool hasSource = false;
+        bool hasTarget = false;
+        std::pair<long, long> edge(0, 0);
+
+        for (Token token = NextToken(); token != Token::LIST_END; token = NextToken()) {
+            if (token != Token::KEY) { Fail("Expected a key in an edge"); }
+
+            if (text_ == "source") {
+                edge.first = ReadInteger("source");
+                hasSource = true;
+            } else if (text_ == "target") {
+                edge.second = ReadInteger("target");
+                hasTarget = true;
+            } else {
+                SkipValueOf(NextToken());
+            }
+        }
+
+        if (!hasSource || !hasTarget) { Fail("An edge has no source or target"); }
+        return edge;
+    }
+
+    DataStructures::VertexType TypeOfShape(const std::string& shape) {
+        if (shape == "rect" || shape == "rectangle" || shape == "box") {
+            return DataStructures::VertexType::turbine;
+        }
+        if (shape == "oval" || shape == "ellipse" || shape == "circle") {
+            return DataStructures::VertexType::substation;
+        }
+        Fail("Could not identify the type of a node with shape '" + shape + "'");
+        return DataStructures::VertexType::turbine;
+    }
+
+    void ExpectListBegin(const std::string& key) {
+        if (NextToken() != Token::LIST_BEGIN) { Fail("Expected '[' after '" + key + "'"); }
+    }
+
+    double ReadNumber(const std::string& key) {
+        if (NextToken() != Token::NUMBER) { Fail("Expected a number after '" + key + "'"); }
+        return std::strtod(text_.c_str(), nullptr);
+    }
+
+    long ReadInteger(const std::string& key) {
+        if (NextToken() != Token::NUMBER) { Fail("Expected an integer after '" + key + "'"); }
+        char* endOfNumber = nullptr;
+        long value = std::strtol(text_.c_str(), &endOfNumber, 10);
+        if (*endOfNumber != '\0') { Fail("Expected an integer after '" + key + "'"); }
+        return value;
+    }
+
+    /**
+     * Skips the value that starts with token, including nested lists.
+     */
+    void SkipValueOf(Token token) {
+        if (token == Token::END || token == Token::LIST_END || token == Token::KEY) {
+            Fail("Expected a value");
+        }
+        if (token != Token::LIST_BEGIN) { return; }
+
+        int depth = 1;
+        while (depth > 0) {
+            Token next = NextToken();
+            if (next == Token::LIST_BEGIN) {
+                ++depth;
+            } else if (next == Token::LIST_END) {
+                --depth;
+            } else if (next == Token::END) {
+                Fail("Missing ']'");
+            }
+        }
+    }
+
+    /**
+     * Reads the next token. The text of keys, numbers and strings is stored in text_.
+     */
+    Token NextToken() {
+        int c = SkipWhitespaceAndComments();
+        if (c == EOF) { return Token::END; }
+
+        if (c == '[') { ++position_; return Token::LIST_BEGIN; }
+        if (c == ']') { ++position_; return Token::LIST_END; }
+
+        text_.clear();
+        if (c == '"') {
+            ++position_;
+            for (c = Get(); c != '"'; c = Get()) {
+                if (c == EOF) { Fail("Unterminated string"); }
+                if (c == '\n') { ++line_; }
+                text_.push_back(static_cast<char>(c));
+            }
+            return Token::STRING;
+        }
+
+        if (std::isalpha(c) || c == '_') {
+            for (c = Peek(); c != EOF && (std::isalnum(c) || c == '_'); c = Peek()) {
+                text_.push_back(static_cast<char>(c));
+                ++position_;
+            }
+            return Token::KEY;
+        }
+
+        if (std::isdigit(c) || c == '-' || c == '+' || c == '.') {
+            for (c = Peek(); c != EOF && (std::isalnum(c) || c == '-' || c == '+' || c == '.'); c = Peek()) {
+                text_.push_back(static_cast<char>(c));
+                ++position_;
+            }
+            return Token::NUMBER;
+        }
+
+        Fail(std::string("Unexpected character '") + static_cast<char>(c) + "'");
+        return Token::END;
+    }
+
+    int SkipWhitespaceAndComments() {
+        for (int c = Peek(); c != EOF; c = Peek()) {
+            if (c == '#') {
+                while (c != EOF && c != '\n') { ++position_; c = Peek(); }
+            } else if (std::isspace(c)) {
+                if (c == '\n') { ++line_; }
+                ++position_;
+            } else {
+                return c;
+            }
+        }
+        return EOF;
+    }
+
+    int Peek() {
+        if (position_ == end_) {
+            input_.read(buffer_.data(), buffer_.size());
+            end_ = static_cast<std::size_t>(input_.gcount());
+            position_ = 0;
+            if (end_ == 0) { return EOF; }
+        }
+        return static_cast<unsigned char>(buffer_[position_]);
+    }
+
+    int Get() {
+        int c = Peek();
+        if (c != EOF) { ++position_; }
+        return c;
+    }
+
+    void Fail(const std::string& message) const {
+        throw "Could not read the GML input in line " + std::to_string(line_) + ": " + message + ".";
+    }
+
+    std::istream& input_;
+    std::vector<char> buffer_;
+    std::size_t position_;
+    std::size_t end_;
+    std::size_t line_;
+    std::string text_;
+
+    static const std::size_t BUFFER_SIZE = 1 << 16;
+};
+
+inline void ReadInstanceFromGMLStream(std::istream& input, DataStructures::Instance& instance, bool useOGDF = false) {
+    if (useOGDF) {
+        instance.ReadFromGMLStreamWithOGDF(input);
+        return;
+    }
+    GMLReader(input).ReadInstance(instance);
+}
+
+/**
+ * Reads the instance in the GML file natively, or with OGDF if useOGDF is set.
+ */
+inline void ReadInstanceFromGMLFile(const std::string& fileName, DataStructures::Instance& instance, bool useOGDF = false) {
+    if (useOGDF) {
+        instance.ReadFromGMLFileWithOGDF(fileName);
+        return;
+    }
+    std::ifstream input(fileName);
+    if (!input.is_open()) {
+        throw std::string("Input file is empty or does not exist.");
+    }
+    GMLReader(input).ReadInstance(instance);
+}
+
+} // namespace IO
+
+} // namespace wcp
+
+#endif
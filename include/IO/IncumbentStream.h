@@ -0,0 +1,127 @@
+#ifndef IO_INCUMBENTSTREAM
+#define IO_INCUMBENTSTREAM
+
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <ostream>
+#include <utility>
+#include <vector>
+
+#include "Auxiliary/Constants.h"
+#include "Auxiliary/Timer.h"
+
+#include "DataStructures/Graphs/Windfarm.h" // for edgeID
+
+namespace wcp {
+
+namespace IO {
+
+/**
+ * An improvement of the best known solution as emitted by IncumbentStream.
+ */
+struct IncumbentUpdate {
+    double elapsedMilliseconds;
+    double cost;
+
+    /**
+     * Pairs of original edge and its new flow for all edges whose flow differs
+     * from the previous update. Empty unless flow changes are requested.
+     */
+    std::vector<std::pair<edgeID, int>> flowChanges;
+};
+
+/**
+ * Passes improvements of the best known solution to a callback while an algorithm runs.
+ *
+ * Updates are rate-limited: an improvement is only emitted if at least the minimum
+ * interval has passed since the last update, unless it is forced, e.g., at the end
+ * of a run. Only strictly better costs than the last emitted one are emitted, so
+ * several runs in parallel can share one stream. The callback is never called
+ * concurrently.
+ */
+class IncumbentStream {
+public:
+    using Callback = std::function<void(const IncumbentUpdate&)>;
+
+    IncumbentStream(Callback callback, double minimumIntervalInMilliseconds, bool includeFlowChanges)
+      : callback_(std::move(callback)),
+        minimumIntervalInMilliseconds_(minimumIntervalInMilliseconds),
+        includeFlowChanges_(includeFlowChanges),
+        lastEmittedCost_(Auxiliary::INFINITE_COST),
+        lastEmissionInMilliseconds_(-Auxiliary::DINFTY) {}
+
+    /**
+     * Returns whether a solution with this cost would be emitted now. This is
+     * cheap, so that it can be checked after every improvement.
+     */
+    bool IsDue(double cost, bool force = false) {
+        if (cost >= lastEmittedCost_.load() - Auxiliary::DOUBLE_ROUNDING_PRECISION) { return false; }
+        return force || timer_.ElapsedMilliseconds() - lastEmissionInMilliseconds_.load() >= minimumIntervalInMilliseconds_;
+    }
+
+    /**
+     * Emits a solution with the given cost, where flowOnEdge returns the flow on
+     * each of the numberOfOriginalEdges original edges.
+     */
+    void Emit(double cost, edgeID numberOfOriginalEdges, const std::function<int(edgeID)>& flowOnEdge) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (cost >= lastEmittedCost_.load() - Auxiliary::DOUBLE_ROUNDING_PRECISION) { return; }
+
+        IncumbentUpdate update;
+        update.elapsedMilliseconds = timer_.ElapsedMilliseconds();
+        update.cost = cost;
+        if (includeFlowChanges_) {
+            // The first update is relative to the zero flow
+            lastEmittedFlow_.resize(numberOfOriginalEdges, 0);
+            for (edgeID edge = 0; edge < numberOfOriginalEdges; ++edge) {
+                int flow = flowOnEdge(edge);
+                if (flow != lastEmittedFlow_[edge]) {
+                    update.flowChanges.emplace_back(edge, flow);
+                    lastEmittedFlow_[edge] = flow;
+                }
+            }
+        }
+
+        callback_(update);
+
+        lastEmittedCost_.store(cost);
+        lastEmissionInMilliseconds_.store(update.elapsedMilliseconds);
+    }
+
+    /**
+     * Returns a callback that writes each update as one JSON object per line to os.
+     * If given, edge e is written as outputIndexOfEdge[e], e.g., its index in the input file.
+     */
+    static Callback JsonLinesWriter(std::ostream& os, std::vector<edgeID> outputIndexOfEdge = {}) {
+        return [&os, outputIndexOfEdge](const IncumbentUpdate& update) {
+            os << "{\"time\":" << update.elapsedMilliseconds << ",\"cost\":" << update.cost;
+            if (!update.flowChanges.empty()) {
+                os << ",\"flow\":[";
+                for (size_t i = 0; i < update.flowChanges.size(); ++i) {
+                    edgeID edge = outputIndexOfEdge.empty() ? update.flowChanges[i].first : outputIndexOfEdge[update.flowChanges[i].first];
+                    os << ((i == 0) ? "" : ",") << "[" << edge << "," << update.flowChanges[i].second << "]";
+                }
+                os << "]";
+            }
+            os << "}" << std::endl;
+        };
+    }
+
+private:
+    Callback callback_;
+    double minimumIntervalInMilliseconds_;
+    bool includeFlowChanges_;
+
+    Auxiliary::Timer timer_;
+    std::mutex mutex_;
+    std::atomic<double> lastEmittedCost_;
+    std::atomic<double> lastEmissionInMilliseconds_;
+    std::vector<int> lastEmittedFlow_;
+};
+
+} // namespace IO
+
+} // namespace wcp
+
+#endif
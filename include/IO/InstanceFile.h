@@ -0,0 +1,144 @@
+#ifndef IO_INSTANCEFILE
+#define IO_INSTANCEFILE
+
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "DataStructures/Graphs/Vertices/Vertex.h"
+#include "DataStructures/Graphs/WindfarmResidual.h"
+#include "DataStructures/Instance.h"
+
+#include "IO/BinaryInstance.h"
+#include "IO/GMLReader.h"
+
+namespace wcp {
+
+namespace IO {
+
+/**
+ * Maps the binary instance in fileName and takes the vertices, edges and cable
+ * types from it. The wind farms built from instance copy their residual graph from
+ * the mapped file instead of computing it. Throws a string if the file is invalid.
+ */
+inline void ReadInstanceFromBinaryFile(const std::string& fileName, DataStructures::Instance& instance) {
+    std::shared_ptr<const BinaryInstance::MappedFile> file = std::make_shared<const BinaryInstance::MappedFile>(fileName);
+    const BinaryInstance::Header& header = file->GetHeader();
+
+    instance.SetCableTypes(std::vector<int>(file->CableCapacities(), file->CableCapacities() + header.numberOfCables),
+                           std::vector<int>(file->CableCosts(), file->CableCosts() + header.numberOfCables));
+
+    for (std::int64_t vertex = 0; vertex < header.numberOfVertices; ++vertex) {
+        DataStructures::VertexType type = static_cast<DataStructures::VertexType>(file->VertexType()[vertex]);
+        if (type != DataStructures::VertexType::turbine && type != DataStructures::VertexType::substation) {
+            throw "Could not identify type of vertex " + std::to_string(vertex) + " in the binary instance '" + fileName + "'.";
+        }
+        instance.AddVertex(file->VertexX()[vertex], file->VertexY()[vertex], type, file->VertexCapacity()[vertex]);
+    }
+    for (std::int64_t edge = 0; edge < header.numberOfOriginalEdges; ++edge) {
+        instance.AddEdge(file->EdgeStart()[edge], file->EdgeEnd()[edge]);
+    }
+    instance.UpdateMembers();
+    instance.EnsurePrerequisites();
+
+    instance.SetPrecomputedResidualGraph(std::move(file));
+}
+
+/**
+ * Writes instance in the binary instance format, including its residual graph.
+ */
+inline void WriteBinaryInstance(const std::string& fileName, const DataStructures::Instance& instance) {
+    DataStructures::WindfarmResidual windfarm(instance);
+    const DataStructures::Cabletypes& cabletypes = instance.CableTypes();
+
+    BinaryInstance::Header header;
+    std::copy(BinaryInstance::MAGIC, BinaryInstance::MAGIC + sizeof(BinaryInstance::MAGIC), header.magic);
+    header.version                  = BinaryInstance::VERSION;
+    header.byteOrderMark            = BinaryInstance::BYTE_ORDER_MARK;
+    header.numberOfVertices         = windfarm.NumberOfOriginalVertices();
+    header.numberOfOriginalEdges    = windfarm.NumberOfOriginalEdges();
+    header.numberOfResidualEdges    = windfarm.NumberOfEdges();
+    header.numberOfCables           = cabletypes.CapacityBreakpoints().size();
+    const BinaryInstance::Layout layout(header);
+
+    std::ofstream os(fileName, std::ios::binary | std::ios::trunc);
+    if (!os.is_open()) {
+        throw "Could not open file '" + fileName + "' for writing the binary instance.";
+    }
+
+    auto WriteSection = [&os](std::size_t offset, const void* data, std::size_t bytes) {
+        static const char padding[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+        os.write(padding, offset - static_cast<std::size_t>(os.tellp()));
+        os.write(static_cast<const char*>(data), bytes);
+    };
+    auto WriteInts = [&WriteSection](std::size_t offset, const std::vector<std::int32_t>& values) {
+        WriteSection(offset, values.data(), values.size() * sizeof(std::int32_t));
+    };
+    auto WriteDoubles = [&WriteSection](std::size_t offset, const std::vector<double>& values) {
+        WriteSection(offset, values.data(), values.size() * sizeof(double));
+    };
+
+    os.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    std::vector<double> x, y;
+    std::vector<std::int32_t> type, capacity;
+    for (const DataStructures::InstanceVertex& vertex : instance.Vertices()) {
+        x.push_back(vertex.x);
+        y.push_back(vertex.y);
+        type.push_back(static_cast<std::int32_t>(vertex.type));
+        capacity.push_back(vertex.capacity);
+    }
+    WriteDoubles(layout.vertexX, x);
+    WriteDoubles(layout.vertexY, y);
+    WriteInts(layout.vertexType, type);
+    WriteInts(layout.vertexCapacity, capacity);
+
+    WriteInts(layout.cableCapacities, std::vector<std::int32_t>(cabletypes.CapacityBreakpoints().begin(), cabletypes.CapacityBreakpoints().end()));
+    WriteInts(layout.cableCosts, std::vector<std::int32_t>(cabletypes.CostBreakpoints().begin(), cabletypes.CostBreakpoints().end()));
+
+    std::vector<std::int32_t> startVertex, endVertex, edgeCapacity;
+    std::vector<double> length;
+    for (edgeID edge = 0; edge < windfarm.NumberOfEdges(); ++edge) {
+        startVertex.push_back(windfarm.StartVertex(edge));
+        endVertex.push_back(windfarm.EndVertex(edge));
+        edgeCapacity.push_back(windfarm.EdgeCapacity(edge));
+        length.push_back(windfarm.Length(edge));
+    }
+    WriteInts(layout.edgeStart, startVertex);
+    WriteInts(layout.edgeEnd, endVertex);
+    WriteInts(layout.edgeCapacity, edgeCapacity);
+    WriteDoubles(layout.edgeLength, length);
+
+    std::vector<std::int64_t> offsets(1, 0);
+    std::vector<std::int32_t> adjacency;
+    for (vertexID vertex = 0; vertex < windfarm.NumberOfVertices(); ++vertex) {
+        adjacency.insert(adjacency.end(), windfarm.OutgoingEdges(vertex).begin(), windfarm.OutgoingEdges(vertex).end());
+        offsets.push_back(adjacency.size());
+    }
+    WriteSection(layout.adjacencyOffsets, offsets.data(), offsets.size() * sizeof(std::int64_t));
+    WriteInts(layout.adjacency, adjacency);
+    WriteSection(layout.size, nullptr, 0);
+
+    if (!os) {
+        throw "Could not write the binary instance '" + fileName + "'.";
+    }
+}
+
+/**
+ * Reads a binary instance or, otherwise, an instance in GML.
+ */
+inline void ReadInstanceFromFile(const std::string& fileName, DataStructures::Instance& instance, bool useOGDFForGML = false) {
+    if (BinaryInstance::IsBinaryInstance(fileName)) {
+        ReadInstanceFromBinaryFile(fileName, instance);
+    } else {
+        ReadInstanceFromGMLFile(fileName, instance, useOGDFForGML);
+    }
+}
+
+} // namespace IO
+
+} // namespace wcp
+
+#endif
@@ -4,11 +4,13 @@
 #include "Auxiliary/Constants.h"
 #include "Auxiliary/ReturnCodes.h"
 
-#include "DataStructures/InputInformation.h"
 #include "DataStructures/Instance.h"
 #include "DataStructures/OutputInformation.h"
+#include "DataStructures/StrategyNames.h"
 
+#include "IO/Auxiliary.h"
 #include "IO/DummyNCCLogger.h"
+#include "IO/FlowFile.h"
 #include "IO/NegativeCycleRuntimeCollection.h"
 #include "IO/NegativeCycleRuntimeRow.h"
 #include "IO/NegativeCycleSummaryRow.h"
@@ -25,34 +27,37 @@ namespace IO {
 struct NCCLogger : public DummyNCCLogger {
 
 public:
-    void AddMeta(DataStructures::Instance& instance, DataStructures::InputInformation& inputInformation, const std::string& algorithmName) {
-        AddMetaToSummary(instance, inputInformation, algorithmName);
+    void AddMeta(DataStructures::Instance& instance, const DataStructures::StrategyNames& strategies, const std::string& algorithmName) {
+        AddMetaToSummary(instance, strategies, algorithmName);
     }
 
-    void AddMetaToSummary(DataStructures::Instance& instance, DataStructures::InputInformation& inputInformation, const std::string& algorithmName) {
+    void AddMetaToSummary(DataStructures::Instance& instance, const DataStructures::StrategyNames& strategies, const std::string& algorithmName) {
         summaryRow_.Name = algorithmName
                     + "-" + instance.longTestsetInstanceString()
-                    + "-" + inputInformation.initialisationStrategy_.toStdString()
-                    + "-" + inputInformation.deltaStrategy_.toStdString()
-                    + "-" + inputInformation.detectionStrategy_.toStdString();
+                    + "-" + strategies.Joined();
         summaryRow_.Testset = instance.TestsetNumber();
         summaryRow_.Instance = instance.InstanceNumber();
-        summaryRow_.InitializationStrategy = inputInformation.initialisationStrategy_.toStdString();
-        summaryRow_.DeltaStrategy = inputInformation.deltaStrategy_.toStdString();
-        summaryRow_.DetectionStrategy = inputInformation.detectionStrategy_.toStdString();
+        summaryRow_.InitializationStrategy = strategies.initialization;
+        summaryRow_.DeltaStrategy = strategies.delta;
+        summaryRow_.DetectionStrategy = strategies.detection;
         summaryRow_.NumberOfTurbines = instance.NumberOfTurbines();
         summaryRow_.NumberOfSubstations = instance.NumberOfSubstations();
         summaryRow_.NumberOfEdges = instance.NumberOfEdges();
     }
 
     void CompleteOutput(DataStructures::Instance& instance,
-                        DataStructures::InputInformation& inputInformation,
+                        const DataStructures::StrategyNames& strategies,
                         const DataStructures::OutputInformation& outputInformation,
                         Algorithms::WindfarmResidual& windfarm,
                         const std::string& algorithmName) {
+        // The metadata and the solution are taken from instance, which does not reflect edits of the wind farm
+        if (windfarm.HasEditedTopology()) {
+            throw std::string("The topology of the wind farm has been edited, so it cannot be output through the instance it was constructed from.");
+        }
+
         if (outputInformation.ShouldPrintSummary() || outputInformation.ShouldPrintDetails() || outputInformation.ShouldBeVerbose()) {
             // ShouldPrintDetails() as well, since we copy metadata from summaryRow_ to runtimeCollection_
-            AddMetaToSummary(instance, inputInformation, algorithmName);
+            AddMetaToSummary(instance, strategies, algorithmName);
         }
 
         if (outputInformation.ShouldPrintSummary()) {
@@ -60,18 +65,23 @@ public:
         }
 
         if (outputInformation.ShouldPrintSolution()) {
-            windfarm.writeFlowToOGDF(instance.Graph(), instance.GraphAttributes());
-            outputGraphAttributesToGRAPHML(instance.GraphAttributes(),
-                                        outputInformation.OutputPath()
+            std::string solutionFileName = outputInformation.OutputPath()
                                         + "WCP" 
                                         + "-" + algorithmName
                                         + "-" + instance.testsetInstanceString()
-                                        + "-" + inputInformation.initialisationStrategy_.toStdString()
-                                        + "-" + inputInformation.deltaStrategy_.toStdString()
-                                        + "-" + inputInformation.detectionStrategy_.toStdString()
-                                        + ".graphml",
+                                        + "-" + strategies.Joined();
+            windfarm.writeFlowToOGDF(instance);
+            outputGraphAttributesToGRAPHML(instance.GraphAttributes(),
+                                        solutionFileName + ".graphml",
                                         outputInformation.ShouldBeVerbose(),
                                         outputInformation.VerboseStream());
+
+            // The same flow in the compact format for --warmStart
+            std::vector<int> flowOnOriginalEdges(windfarm.NumberOfOriginalEdges());
+            for (int edge = 0; edge < windfarm.NumberOfOriginalEdges(); ++edge) {
+                flowOnOriginalEdges[edge] = windfarm.FlowOnEdge(edge);
+            }
+            FlowFile::WriteBinary(solutionFileName + ".flow", instance.ToOriginalEdgeOrder(flowOnOriginalEdges));
         }
 
         if (outputInformation.ShouldPrintDetails()) {
@@ -79,9 +89,7 @@ public:
                     + "WCP"
                     + "-" + algorithmName
                     + "-" + instance.testsetInstanceString()
-                    + "-" + inputInformation.initialisationStrategy_.toStdString()
-                    + "-" + inputInformation.deltaStrategy_.toStdString()
-                    + "-" + inputInformation.detectionStrategy_.toStdString()
+                    + "-" + strategies.Joined()
                     + ".csv",
                     summaryRow_,
                     outputInformation.ShouldBeVerbose(),
@@ -177,6 +185,19 @@ public:
         SummaryRow().NumberOfRelaxedEdges += newlyRelaxedEdges;
     }
 
+    /**
+     * Adds the detection runs, relaxed edges and cycles counted by other, e.g., by a subproblem.
+     */
+    void AddCountersOf(const NCCLogger& other) {
+        const NegativeCycleSummaryRow& otherRow = other.summaryRow_;
+        SummaryRow().NumberOfDetectionRuns += otherRow.NumberOfDetectionRuns;
+        SummaryRow().NumberOfRelaxedEdges += otherRow.NumberOfRelaxedEdges;
+        SummaryRow().NumberOfNegativeCycles += otherRow.NumberOfNegativeCycles;
+        SummaryRow().NumberOfSimpleCycles += otherRow.NumberOfSimpleCycles;
+        SummaryRow().NumberOfEdgesSimpleCycles += otherRow.NumberOfEdgesSimpleCycles;
+        SummaryRow().NumberOfEdgesOnCanceledCycles += otherRow.NumberOfEdgesOnCanceledCycles;
+    }
+
     int NumberOfDetectionRuns() { return SummaryRow().NumberOfDetectionRuns; }
 
     IO::NegativeCycleRuntimeCollection& RuntimeCollection() { return runtimeCollection_; }
@@ -25,7 +25,7 @@ inline void addCommandLineOptionsForNCC(QCommandLineParser& parser) {
 
     QCommandLineOption deltaOption(
             "delta",
-            "Delta strategy of form '*(STAY)?(INC|DEC|INCDEC|RANDOM)' (default: INC).",
+            "Delta strategy of form '*(STAY)?(INC|DEC|INCDEC|RANDOM|ADAPTIVE)' (default: INC).",
             "Strategy", "INC"
     );
     parser.addOption(deltaOption);
@@ -64,6 +64,133 @@ inline void addCommandLineOptionsForNCC(QCommandLineParser& parser) {
             "Weight", "0"
     );
     parser.addOption(escapeBonbonOption);
+
+    QCommandLineOption portfolioOption(
+            "portfolio",
+            "Comma-separated list of strategy combinations of form 'INIT:DELTA:DETECT' that are run in parallel; the best solution is reported (default: none).",
+            "Combinations"
+    );
+    parser.addOption(portfolioOption);
+
+    QCommandLineOption threadsOption(
+            "threads",
+            "Number of threads used for a portfolio or for parallel chains (default: 0, i.e., number of hardware threads).",
+            "Number", "0"
+    );
+    parser.addOption(threadsOption);
+
+    QCommandLineOption chainsOption(
+            "chains",
+            "Number of EscapingNCC chains with seeds seed, seed+1, ... that run in parallel and share their best solution (default: 1).",
+            "Number", "1"
+    );
+    parser.addOption(chainsOption);
+
+    QCommandLineOption localHopsOption(
+            "localHops",
+            "Before each global detection run, search for negative cycles within this many hops of the last canceled cycles (default: 0, i.e., no local search).",
+            "Hops", "0"
+    );
+    parser.addOption(localHopsOption);
+
+    QCommandLineOption windowsOption(
+            "windows",
+            "Before each NCC run, cancel cycles within a grid of this many overlapping windows per axis until no window improves (default: 1, i.e., no windows).",
+            "Number", "1"
+    );
+    parser.addOption(windowsOption);
+
+    parser.addOption({"decompose", "Before each NCC run, cancel cycles within the cluster of turbines of each substation in parallel."});
+
+    QCommandLineOption epsilonOption(
+            "epsilon",
+            "Only cancel cycles with costs below -epsilon per edge, halving epsilon until it is negligible, before canceling all negative cycles (default: 0, i.e., no epsilon scaling).",
+            "Epsilon", "0"
+    );
+    parser.addOption(epsilonOption);
+
+    QCommandLineOption streamOption(
+            "stream",
+            "Write each improvement of the best solution as a JSON line to this file while the algorithm runs; '-' writes to standard out (default: none).",
+            "File"
+    );
+    parser.addOption(streamOption);
+
+    QCommandLineOption streamIntervalOption(
+            "stream-interval",
+            "Minimum time in milliseconds between two streamed improvements (default: 1000).",
+            "Milliseconds", "1000"
+    );
+    parser.addOption(streamIntervalOption);
+
+    parser.addOption({"stream-flow", "Add the changed flow values to each streamed improvement."});
+
+    QCommandLineOption batchOption(
+            "batch",
+            "Solve all instances listed in this file (one path per line) or all .gml files in this directory instead of --inputFile (default: none).",
+            "ListOrDirectory"
+    );
+    parser.addOption(batchOption);
+
+    QCommandLineOption gridOption(
+            "grid",
+            "In batch mode, solve each instance with each of these comma-separated strategy combinations 'INIT:DELTA:DETECT' (default: the strategies given by --init, --delta and --detect).",
+            "Combinations"
+    );
+    parser.addOption(gridOption);
+
+    parser.addOption({"server", "Stay resident and solve the JSON requests read line by line from standard in; the responses go to standard out."});
+
+    QCommandLineOption socketOption(
+            "socket",
+            "Like --server, but read the requests from clients of a UNIX domain socket created at this path (default: none).",
+            "Path"
+    );
+    parser.addOption(socketOption);
+
+    parser.addOption({"ogdf-reader", "Read the instances with OGDF instead of the native GML reader."});
+
+    QCommandLineOption renumberOption(
+            "renumber",
+            "Renumber the vertices and edges of the instance for locality: HILBERT (along a Hilbert curve through the coordinates), RCM (reverse Cuthill-McKee) or NONE; solutions keep the numbering of the input file (default: NONE).",
+            "Order", "NONE"
+    );
+    parser.addOption(renumberOption);
+
+    QCommandLineOption convertOption(
+            "convert",
+            "Write the instance with its residual graph to this file in the binary instance format and exit (default: none).",
+            "File"
+    );
+    parser.addOption(convertOption);
+
+    QCommandLineOption warmStartOption(
+            "warmStart",
+            "Start from the flow in this file instead of computing an initial flow. The file is a GraphML solution or a binary flow file written with --print-solution (default: none).",
+            "File"
+    );
+    parser.addOption(warmStartOption);
+
+    QCommandLineOption checkpointOption(
+            "checkpoint",
+            "Periodically write the state of EscapingNCC to this file, so that the run can be resumed (default: none).",
+            "File"
+    );
+    parser.addOption(checkpointOption);
+
+    QCommandLineOption checkpointIntervalOption(
+            "checkpoint-interval",
+            "Minimum time in seconds between two checkpoints (default: 60).",
+            "Seconds", "60"
+    );
+    parser.addOption(checkpointIntervalOption);
+
+    QCommandLineOption resumeOption(
+            "resume",
+            "Continue EscapingNCC from the checkpoint in this file instead of computing an initial flow (default: none).",
+            "File"
+    );
+    parser.addOption(resumeOption);
 }
 
 inline void addCommandLineOptions(QCommandLineParser& parser) {
@@ -140,6 +267,115 @@ inline void ProcessNCCInput(QCommandLineParser& parser,
     if (!didAllconversionWork) {
         throw std::string("Could not identify weight for an escaping strategy.");
     }
+
+    inputInfo.isPortfolioSet_ = parser.isSet("portfolio");
+    inputInfo.portfolio_ = parser.value("portfolio").toUpper();
+
+    bool threadConversionWorked = true;
+    inputInfo.numberOfThreads_ = parser.value("threads").toUInt(&threadConversionWorked);
+    if (!threadConversionWorked) {
+        throw std::string("Could not identify the number of threads.");
+    }
+
+    bool chainConversionWorked = true;
+    inputInfo.numberOfChains_ = parser.value("chains").toUInt(&chainConversionWorked);
+    if (!chainConversionWorked || inputInfo.numberOfChains_ == 0) {
+        throw std::string("Could not identify a positive number of chains.");
+    }
+
+    bool localHopsConversionWorked = true;
+    inputInfo.localSearchHops_ = parser.value("localHops").toUInt(&localHopsConversionWorked);
+    if (!localHopsConversionWorked) {
+        throw std::string("Could not identify the number of hops for local detection.");
+    }
+
+    bool windowsConversionWorked = true;
+    inputInfo.numberOfWindowsPerAxis_ = parser.value("windows").toUInt(&windowsConversionWorked);
+    if (!windowsConversionWorked || inputInfo.numberOfWindowsPerAxis_ == 0) {
+        throw std::string("Could not identify a positive number of windows.");
+    }
+
+    inputInfo.decomposeBySubstations_ = parser.isSet("decompose");
+
+    bool epsilonConversionWorked = true;
+    inputInfo.initialEpsilon_ = parser.value("epsilon").toDouble(&epsilonConversionWorked);
+    if (!epsilonConversionWorked || inputInfo.initialEpsilon_ < 0) {
+        throw std::string("Could not identify a non-negative epsilon.");
+    }
+
+    inputInfo.isIncumbentStreamSet_ = parser.isSet("stream");
+    inputInfo.incumbentStreamFile_ = parser.value("stream");
+    inputInfo.streamFlowChanges_ = parser.isSet("stream-flow");
+
+    bool streamIntervalConversionWorked = true;
+    inputInfo.incumbentStreamIntervalInMilliseconds_ = parser.value("stream-interval").toDouble(&streamIntervalConversionWorked);
+    if (!streamIntervalConversionWorked || inputInfo.incumbentStreamIntervalInMilliseconds_ < 0) {
+        throw std::string("Could not identify a non-negative interval for streaming.");
+    }
+
+    inputInfo.isBatchSet_ = parser.isSet("batch");
+    inputInfo.batchInput_ = parser.value("batch");
+    inputInfo.isGridSet_ = parser.isSet("grid");
+    inputInfo.grid_ = parser.value("grid").toUpper();
+
+    inputInfo.serverSocket_ = parser.value("socket");
+    inputInfo.isServerSet_ = parser.isSet("server") || parser.isSet("socket");
+
+    inputInfo.useOGDFReader_ = parser.isSet("ogdf-reader");
+    inputInfo.vertexOrder_ = parser.value("renumber").toUpper();
+    if (inputInfo.vertexOrder_ != "NONE" && inputInfo.vertexOrder_ != "HILBERT" && inputInfo.vertexOrder_ != "RCM") {
+        throw std::string("Could not identify the vertex order for --renumber.");
+    }
+    inputInfo.isConvertSet_ = parser.isSet("convert");
+    inputInfo.convertFile_ = parser.value("convert");
+
+    inputInfo.isWarmStartSet_ = parser.isSet("warmStart");
+    inputInfo.warmStartFile_ = parser.value("warmStart");
+    if (inputInfo.isWarmStartSet_) {
+        inputInfo.initialisationStrategy_ = "FROMFILE";
+    }
+
+    inputInfo.isCheckpointSet_ = parser.isSet("checkpoint");
+    inputInfo.checkpointFile_ = parser.value("checkpoint");
+    inputInfo.isResumeSet_ = parser.isSet("resume");
+    inputInfo.resumeFile_ = parser.value("resume");
+
+    bool checkpointIntervalConversionWorked = true;
+    inputInfo.checkpointIntervalInSeconds_ = parser.value("checkpoint-interval").toDouble(&checkpointIntervalConversionWorked);
+    if (!checkpointIntervalConversionWorked || inputInfo.checkpointIntervalInSeconds_ < 0) {
+        throw std::string("Could not identify a non-negative interval for checkpoints.");
+    }
+}
+
+/**
+ * Sets the input file and takes the testset and instance number from the first
+ * two occurrences of a dash followed by a number in its name.
+ */
+inline void SetInputFile(const QString& inputFile, DataStructures::InputInformation& inputInfo) {
+    inputInfo.inputfile_ = inputFile;
+
+    QRegularExpression rx("-(\\d+)");
+
+    QList<int> list;
+    QRegularExpressionMatchIterator i = rx.globalMatch(inputFile);
+    while (i.hasNext()) {
+        QRegularExpressionMatch match = i.next();
+        QString word = match.captured(1);
+        list << word.toInt();
+    }
+    if (list.size() >= 2) {
+        inputInfo.testsetNumber_ = list[0];
+        inputInfo.instanceNumber_ = list[1];
+    } else {
+        fprintf(stderr, "%s\n", "Warning: Could not identify testset or instance number. Inserting standard values ...");
+        if (list.size() == 1) {
+            inputInfo.testsetNumber_ = list[0];
+            inputInfo.instanceNumber_ = Auxiliary::INFTY;
+        } else {
+            inputInfo.testsetNumber_ = Auxiliary::INFTY;
+            inputInfo.instanceNumber_ = Auxiliary::INFTY;
+        }
+    }
 }
 
 inline void ProcessCommandLineInput(const QCoreApplication& application,
@@ -170,31 +406,8 @@ inline void ProcessCommandLineInput(const QCoreApplication& application,
     }
 
     if (parser.isSet("inputFile")) {
-        inputInfo.inputfile_  = parser.value("inputFile");
-
-        QRegularExpression rx("-(\\d+)");
-
-        QList<int> list;
-        QRegularExpressionMatchIterator i = rx.globalMatch(parser.value("inputFile"));
-        while (i.hasNext()) {
-            QRegularExpressionMatch match = i.next();
-            QString word = match.captured(1);
-            list << word.toInt();
-        }
-        if (list.size() >= 2) {
-            inputInfo.testsetNumber_ = list[0];
-            inputInfo.instanceNumber_ = list[1];
-        } else {
-            fprintf(stderr, "%s\n", "Warning: Could not identify testset or instance number. Inserting standard values ...");
-            if (list.size() == 1) {
-                inputInfo.testsetNumber_ = list[0];
-                inputInfo.instanceNumber_ = Auxiliary::INFTY;
-            } else {
-                inputInfo.testsetNumber_ = Auxiliary::INFTY;
-                inputInfo.instanceNumber_ = Auxiliary::INFTY;
-            }
-        }
-    } else {
+        SetInputFile(parser.value("inputFile"), inputInfo);
+    } else if (!parser.isSet("batch") && !inputInfo.isServerSet_) {
         fprintf(stderr, "%s\n", "Error: Must specify an input file.");
         parser.showHelp(1);
         exit(1);
@@ -0,0 +1,186 @@
+#ifndef IO_SERVERPROTOCOL
+#define IO_SERVERPROTOCOL
+
+#include <string>
+#include <vector>
+
+#include <QByteArray>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonValue>
+#include <QString>
+#include <QStringList>
+
+#include "DataStructures/InputInformation.h"
+
+#include "IO/IncumbentStream.h"
+
+namespace wcp {
+
+namespace IO {
+
+/**
+ * The line-delimited JSON protocol of the solver server. Each request is one JSON
+ * object on a single line, e.g.,
+ *
+ *   {"id":1,"instance":"farm-1-2.gml","algorithm":"EscapingNCC","time":10,"stream":true}
+ *
+ * where the instance is given by its path ("instance") or inline as GML text ("graph").
+ * Further keys are "init", "delta", "detect", "iterations" and "seed" with the meaning of
+ * the respective command-line options, which provide the defaults, as well as "flow"
+ * (include the flow in the result, default: true), "stream" (report improvements during
+ * the run, default: false) and "streamInterval" (in milliseconds, default: 1000).
+ *
+ * Each response is one JSON object on a single line that repeats the id of its request
+ * and has a "type" of "improvement", "result" or "error".
+ */
+namespace ServerProtocol {
+
+struct Request {
+    QJsonValue id;
+    std::string instancePath;
+    std::string inlineGraph;
+    bool includeFlow = true;
+    bool streamImprovements = false;
+    double streamIntervalInMilliseconds = 1000;
+};
+
+inline std::string ToLine(const QJsonObject& object) {
+    return QJsonDocument(object).toJson(QJsonDocument::Compact).toStdString() + "\n";
+}
+
+inline QString StringOf(const QJsonObject& object, const QString& key) {
+    if (!object.value(key).isString()) {
+        throw "The value of '" + key.toStdString() + "' must be a string.";
+    }
+    return object.value(key).toString();
+}
+
+inline double NumberOf(const QJsonObject& object, const QString& key) {
+    if (!object.value(key).isDouble()) {
+        throw "The value of '" + key.toStdString() + "' must be a number.";
+    }
+    return object.value(key).toDouble();
+}
+
+inline bool BoolOf(const QJsonObject& object, const QString& key) {
+    if (!object.value(key).isBool()) {
+        throw "The value of '" + key.toStdString() + "' must be true or false.";
+    }
+    return object.value(key).toBool();
+}
+
+/**
+ * Parses a request and applies its options to inputInformation, which holds the defaults.
+ * Throws a string if the request is malformed; the id is set as far as it could be read.
+ */
+inline void ParseRequest(const std::string& line, Request& request, DataStructures::InputInformation& inputInformation) {
+    QJsonParseError parseError;
+    QJsonDocument document = QJsonDocument::fromJson(QByteArray::fromStdString(line), &parseError);
+    if (!document.isObject()) {
+        throw "The request is no JSON object: " + parseError.errorString().toStdString();
+    }
+    const QJsonObject object = document.object();
+    request.id = object.value("id");
+
+    for (const QString& key : object.keys()) {
+        if (key == "id") {
+            continue;
+        } else if (key == "instance") {
+            request.instancePath = StringOf(object, key).toStdString();
+        } else if (key == "graph") {
+            request.inlineGraph = StringOf(object, key).toStdString();
+        } else if (key == "algorithm") {
+            inputInformation.algorithm_ = StringOf(object, key).toUpper();
+            inputInformation.algorithmStdString_ = inputInformation.algorithm_.toStdString();
+            if (!inputInformation.algorithm_.endsWith("NCC")) {
+                throw "Unknown algorithm \"" + inputInformation.algorithmStdString_ + "\"";
+            }
+        } else if (key == "init") {
+            inputInformation.initialisationStrategy_ = StringOf(object, key).toUpper();
+        } else if (key == "delta") {
+            inputInformation.deltaStrategy_ = StringOf(object, key).toUpper();
+        } else if (key == "detect") {
+            inputInformation.detectionStrategy_ = StringOf(object, key).toUpper();
+        } else if (key == "time") {
+            inputInformation.isTimeLimitSet_ = true;
+            inputInformation.timeLimitInSeconds_ = NumberOf(object, key);
+            if (inputInformation.timeLimitInSeconds_ <= 0) {
+                throw std::string("Non-positive time limit is invalid.");
+            }
+        } else if (key == "iterations") {
+            double iterations = NumberOf(object, key);
+            if (iterations < 0) {
+                throw std::string("Negative iteration limit is invalid.");
+            }
+            inputInformation.isIterationLimitSet_ = true;
+            inputInformation.iterationLimit_ = static_cast<unsigned int>(iterations);
+        } else if (key == "seed") {
+            inputInformation.randomSeed_ = static_cast<int>(NumberOf(object, key));
+        } else if (key == "flow") {
+            request.includeFlow = BoolOf(object, key);
+        } else if (key == "stream") {
+            request.streamImprovements = BoolOf(object, key);
+        } else if (key == "streamInterval") {
+            request.streamIntervalInMilliseconds = NumberOf(object, key);
+        } else {
+            throw "Unknown key '" + key.toStdString() + "' in request.";
+        }
+    }
+
+    if (request.instancePath.empty() == request.inlineGraph.empty()) {
+        throw std::string("A request needs exactly one of 'instance' and 'graph'.");
+    }
+}
+
+inline std::string ErrorResponse(const QJsonValue& id, const std::string& message) {
+    QJsonObject response;
+    response.insert("id", id);
+    response.insert("type", "error");
+    response.insert("message", QString::fromStdString(message));
+    return ToLine(response);
+}
+
+inline std::string ImprovementResponse(const QJsonValue& id, const IncumbentUpdate& update) {
+    QJsonObject response;
+    response.insert("id", id);
+    response.insert("type", "improvement");
+    response.insert("time", update.elapsedMilliseconds);
+    response.insert("cost", update.cost);
+    return ToLine(response);
+}
+
+/**
+ * The flow is given per original edge in the order of the edges of the instance.
+ */
+inline std::string ResultResponse(const QJsonValue& id,
+                                  int status,
+                                  double cost,
+                                  double elapsedMilliseconds,
+                                  bool wasInstanceCached,
+                                  const std::vector<int>* flowOnOriginalEdges) {
+    QJsonObject response;
+    response.insert("id", id);
+    response.insert("type", "result");
+    response.insert("status", status);
+    response.insert("cost", cost);
+    response.insert("time", elapsedMilliseconds);
+    response.insert("cached", wasInstanceCached);
+    if (flowOnOriginalEdges != nullptr) {
+        QJsonArray flow;
+        for (int flowOnEdge : *flowOnOriginalEdges) {
+            flow.append(flowOnEdge);
+        }
+        response.insert("flow", flow);
+    }
+    return ToLine(response);
+}
+
+} // namespace ServerProtocol
+
+} // namespace IO
+
+} // namespace wcp
+
+#endif
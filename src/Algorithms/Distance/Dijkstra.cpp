@@ -12,6 +12,10 @@ ReturnCode Dijkstra::Run() {
     queue_.push(Entry{startVertex_, 0.0});
 
     while (!queue_.empty()) {
+        if (cancellationToken_ != nullptr && cancellationToken_->IsCancelledAfterManyCalls()) {
+            return ReturnCode::TIME_LIMIT;
+        }
+
         Entry current = queue_.top();
         queue_.pop();
 
@@ -15,16 +15,17 @@ void EscapingBonbons::SetIncomingBonbonEdgeForVertex(edgeID edgeInBonbon) {
     }
 }
 
-void EscapingBonbons::RecoverBonbon(EscapingNCC& ncc) {
+ReturnCode EscapingBonbons::RecoverBonbon(EscapingNCC& ncc) {
     assert(ncc.bonbon_.changeOfFlow != -1);
     ncc.ComputeResidualCosts(ncc.bonbon_.changeOfFlow);
 
-#ifndef NDEBUG
     ReturnCode detectionCode = ncc.DetectionStrategy().Run();
+    if (detectionCode == ReturnCode::TIME_LIMIT) {
+        bonbon_.clear();
+        return ReturnCode::TIME_LIMIT;
+    }
     assert(detectionCode == ReturnCode::SUCCESS);
-#else
-    (void) ncc.DetectionStrategy().Run();
-#endif
+
     bonbon_ = ncc.DetectionStrategy().TraverseParentsUntilParticularEdgeRepeats(ncc.bonbon_.edgeOnBonbon);
 
     assert(bonbon_.size() > 1);
@@ -39,6 +40,7 @@ void EscapingBonbons::RecoverBonbon(EscapingNCC& ncc) {
         }
         ncc.verboseStream_ << '\n';
     }
+    return ReturnCode::SUCCESS;
 }
 
 ReturnCode EscapingBonbons::SpecialTreatmentIfTailIsClosed(EscapingNCC& ncc, std::vector<edgeID>& tail, double costOfTail) {
@@ -100,11 +102,11 @@ ReturnCode EscapingBonbons::CheckAllIncomingEdgesForTail(EscapingNCC& ncc, edgeI
         // incomingEdge enters StartVertex of negative edge to (hopefully) form negative cycle
         edgeID incomingEdge = Windfarm().ReverseEdgeIndex(outgoingEdge);
 
-        std::vector<edgeID> tail = ncc.DetectionStrategy().TraverseParentsUntilWalkStarts(bonbon_, incomingEdge);
-        if (tail.empty()) { continue; }
+        ncc.DetectionStrategy().TraverseParentsUntilWalkStarts(bonbon_, incomingEdge, tail_);
+        if (tail_.empty()) { continue; }
         
 
-        ReturnCode resultOfCombiningTailAndBonbon = CombineTailAndBonbon(ncc, tail);
+        ReturnCode resultOfCombiningTailAndBonbon = CombineTailAndBonbon(ncc, tail_);
         if (resultOfCombiningTailAndBonbon == ReturnCode::SUCCESS) { return resultOfCombiningTailAndBonbon; }
     }
     return ReturnCode::NOTHING_CHANGED;
@@ -113,7 +115,7 @@ ReturnCode EscapingBonbons::CheckAllIncomingEdgesForTail(EscapingNCC& ncc, edgeI
 void EscapingBonbons::UpdateVectorOfBonbonEdgesForVertices(unsigned int currentIndexInBonbon) {
     assert(currentIndexInBonbon < bonbon_.size());
 
-    firstEdgeInWalkLeadingToVertex_ = std::vector<edgeID>(Windfarm().NumberOfVertices(), INVALID_EDGE);
+    firstEdgeInWalkLeadingToVertex_.assign(Windfarm().NumberOfVertices(), INVALID_EDGE);
     // Start at the current negative edge. With that, we make sure that we obtain a simple cycle
     // if we combine the tail with the edges as given in firstEdgeInWalkLeadingToVertex_.
     unsigned int index = currentIndexInBonbon;
@@ -138,7 +140,7 @@ ReturnCode EscapingBonbons::apply(EscapingNCC& ncc) {
     if (ncc.bonbon_.edgeOnBonbon == INVALID_EDGE) {
         return ReturnCode::NOTHING_CHANGED;
     } else {
-        RecoverBonbon(ncc);
+        if (RecoverBonbon(ncc) == ReturnCode::TIME_LIMIT) { return ReturnCode::TIME_LIMIT; }
 
         for (unsigned int walkIndex = 0; walkIndex + 1 < bonbon_.size(); walkIndex++) {
             if (Windfarm().ResidualCostOnEdge(bonbon_[walkIndex]) < 0) {
@@ -167,27 +167,25 @@ edgeID EscapingLeaves::SingleDFSStepToFindPathToRepeatingEdge(edgeID edgeToRepea
     }
     return INVALID_EDGE;
 }
-std::vector<edgeID> EscapingLeaves::PopulateParentPointersUntilEdgeRepeats(edgeID edgeToRepeat, edgeID edgeToStartSearchWith) {
-    std::vector<edgeID> NextEdgeToASubstation(Windfarm().NumberOfEdges(), INVALID_EDGE);
+void EscapingLeaves::PopulateParentPointersUntilEdgeRepeats(edgeID edgeToRepeat, edgeID edgeToStartSearchWith) {
+    nextEdgeToASubstation_.resize(Windfarm().NumberOfEdges(), INVALID_EDGE);
     bool hasEdgeToRepeatAlreadyBeenSeen = false;
 
 #ifndef NDEBUG
-    edgeID edgeThatShouldBeTheFirstEdge = SingleDFSStepToFindPathToRepeatingEdge(edgeToRepeat, edgeToStartSearchWith, hasEdgeToRepeatAlreadyBeenSeen, NextEdgeToASubstation);
+    edgeID edgeThatShouldBeTheFirstEdge = SingleDFSStepToFindPathToRepeatingEdge(edgeToRepeat, edgeToStartSearchWith, hasEdgeToRepeatAlreadyBeenSeen, nextEdgeToASubstation_);
     assert(edgeThatShouldBeTheFirstEdge == edgeToStartSearchWith);
 #else
-    (void) SingleDFSStepToFindPathToRepeatingEdge(edgeToRepeat, edgeToStartSearchWith, hasEdgeToRepeatAlreadyBeenSeen, NextEdgeToASubstation);
+    (void) SingleDFSStepToFindPathToRepeatingEdge(edgeToRepeat, edgeToStartSearchWith, hasEdgeToRepeatAlreadyBeenSeen, nextEdgeToASubstation_);
 #endif
-
-    return NextEdgeToASubstation;
 }
 
 void EscapingLeaves::CancelCycleWithAllPositiveFlow(edgeID edgeOnCycle, edgeID firstEdgeInSearch) {
-    std::vector<edgeID> NextEdgeToASubstation = PopulateParentPointersUntilEdgeRepeats(edgeOnCycle, firstEdgeInSearch);
+    PopulateParentPointersUntilEdgeRepeats(edgeOnCycle, firstEdgeInSearch);
 
     std::vector<edgeID> edgesOnCycle;
     do {
         edgesOnCycle.push_back(edgeOnCycle);
-        edgeOnCycle = NextEdgeToASubstation[edgeOnCycle];
+        edgeOnCycle = nextEdgeToASubstation_[edgeOnCycle];
     } while (edgeOnCycle != edgesOnCycle.front());
 
     int delta = Windfarm().FindMinimumFlowOnEdges(edgesOnCycle);
@@ -195,11 +193,11 @@ void EscapingLeaves::CancelCycleWithAllPositiveFlow(edgeID edgeOnCycle, edgeID f
     Windfarm().AddFlowOnMultipleEdges(edgesOnCycle, -delta);
 }
 
-edgeID EscapingLeaves::ExploreEdgeWhenFindingPreviousSubstation(std::vector<bool>& hasEdgeAlreadyBeenExplored,
+edgeID EscapingLeaves::ExploreEdgeWhenFindingPreviousSubstation(Auxiliary::EpochMarks& hasEdgeAlreadyBeenExplored,
                                                                 std::vector<edgeID>& invertedPathToPreviousSubstation,
                                                                 edgeID edgeToExplore,
                                                                 edgeID firstEdgeInSearch) {
-    if (hasEdgeAlreadyBeenExplored[edgeToExplore]) {
+    if (hasEdgeAlreadyBeenExplored.IsMarked(edgeToExplore)) {
         CancelCycleWithAllPositiveFlow(edgeToExplore, firstEdgeInSearch);
         invertedPathToPreviousSubstation.push_back(INVALID_EDGE);
         return INVALID_EDGE;
@@ -229,25 +227,25 @@ std::vector<edgeID> EscapingLeaves::IdentifyInvertedPathToPreviousSubstation(Lea
     // In that case we need to run the procedure again to identify the path to the substation.
     do {
         invertedPathToPreviousSubstation.clear();
-        std::vector<bool> hasEdgeAlreadyBeenExplored(Windfarm().NumberOfEdges(), false);
+        hasEdgeAlreadyBeenExplored_.Clear(Windfarm().NumberOfEdges());
         // We do not need the edge returned by the function but rather the vector entries in invertedPathToPreviousSubstation.
-        (void) ExploreEdgeWhenFindingPreviousSubstation(hasEdgeAlreadyBeenExplored, invertedPathToPreviousSubstation, leaf.CurrentEdge(), leaf.CurrentEdge());
+        (void) ExploreEdgeWhenFindingPreviousSubstation(hasEdgeAlreadyBeenExplored_, invertedPathToPreviousSubstation, leaf.CurrentEdge(), leaf.CurrentEdge());
     } while (invertedPathToPreviousSubstation.front() == INVALID_EDGE);
 
     assert(invertedPathToPreviousSubstation.back() == leaf.CurrentEdge());
     return invertedPathToPreviousSubstation;
 }
 
-edgeID EscapingLeaves::ExploreEdgeWhenFindingNewSubstation( std::vector<bool>& hasEdgeAlreadyBeenExplored,
+edgeID EscapingLeaves::ExploreEdgeWhenFindingNewSubstation( Auxiliary::EpochMarks& hasEdgeAlreadyBeenExplored,
                                                             std::vector<edgeID>& invertedPathToNewSubstation,
                                                             edgeID edgeToExplore,
                                                             edgeID firstEdgeInSearch,
                                                             vertexID previousSubstation) {
-    if (hasEdgeAlreadyBeenExplored[edgeToExplore]) {
+    if (hasEdgeAlreadyBeenExplored.IsMarked(edgeToExplore)) {
         CancelCycleWithAllPositiveFlow(edgeToExplore, firstEdgeInSearch);
         return INVALID_EDGE;
     } else {
-        hasEdgeAlreadyBeenExplored[edgeToExplore] = true;
+        hasEdgeAlreadyBeenExplored.Mark(edgeToExplore);
     }
 
     if (Windfarm().IsSubstation(Windfarm().EndVertex(edgeToExplore))) {
@@ -280,17 +278,17 @@ edgeID EscapingLeaves::ExploreEdgeWhenFindingNewSubstation( std::vector<bool>& h
 
 std::vector<edgeID> EscapingLeaves::IdentifyInvertedPathToNewSubstation(LeafTurbine& leaf, vertexID previousSubstation) {
     std::vector<edgeID> invertedPathToNewSubstation;
-    std::vector<bool> hasEdgeAlreadyBeenExplored(Windfarm().NumberOfEdges(), false);
+    hasEdgeAlreadyBeenExplored_.Clear(Windfarm().NumberOfEdges());
 
 #ifndef NDEBUG
-    edgeID firstEdge = ExploreEdgeWhenFindingNewSubstation(hasEdgeAlreadyBeenExplored, invertedPathToNewSubstation, leaf.ShorterEdge(), leaf.ShorterEdge(), previousSubstation);
+    edgeID firstEdge = ExploreEdgeWhenFindingNewSubstation(hasEdgeAlreadyBeenExplored_, invertedPathToNewSubstation, leaf.ShorterEdge(), leaf.ShorterEdge(), previousSubstation);
     if (firstEdge == INVALID_EDGE) {
         assert(invertedPathToNewSubstation.empty());
     } else {
         assert(invertedPathToNewSubstation.back() == leaf.ShorterEdge());
     }
 #else
-    (void) ExploreEdgeWhenFindingNewSubstation(hasEdgeAlreadyBeenExplored, invertedPathToNewSubstation, leaf.ShorterEdge(), leaf.ShorterEdge(), previousSubstation);
+    (void) ExploreEdgeWhenFindingNewSubstation(hasEdgeAlreadyBeenExplored_, invertedPathToNewSubstation, leaf.ShorterEdge(), leaf.ShorterEdge(), previousSubstation);
 #endif
 
     return invertedPathToNewSubstation;
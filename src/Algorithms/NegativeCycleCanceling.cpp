@@ -1,5 +1,13 @@
 #include "Algorithms/NegativeCycleCanceling.h"
 
+#include <algorithm>
+
+#include "Algorithms/ClusterNCC.h"
+#include "Algorithms/SpatialWindows.h"
+#include "Algorithms/SubstationClusters.h"
+
+#include "Auxiliary/ThreadPool.h"
+
 namespace wcp {
 
 namespace Algorithms {
@@ -38,42 +46,262 @@ ReturnCode NegativeCycleCanceling::ComputeInitialFlow() {
 }
 
 ReturnCode NegativeCycleCanceling::RunNCCforAllDeltas() {
+    // Once a phase exceeds the time limit, the remaining phases are skipped, but the run is still completed below
+    ReturnCode phaseCode = ReturnCode::NOTHING_CHANGED;
+    if (settings_.decomposeBySubstations) {
+        phaseCode = RunDecomposedNCC();
+    }
+
+    if (phaseCode != ReturnCode::TIME_LIMIT && settings_.numberOfWindowsPerAxis > 1) {
+        phaseCode = RunWindowedNCC();
+    }
+
+    if (phaseCode != ReturnCode::TIME_LIMIT && settings_.initialEpsilon > 0) {
+        phaseCode = RunEpsilonScaledNCC();
+    }
+
+    if (phaseCode != ReturnCode::TIME_LIMIT) {
+        CancelNegativeCyclesForAllDeltas();
+    }
+
+#ifndef NDEBUG
+    AssertFeasibleFlow(windfarm_);
+#endif
+
+    double millisecondsAtCompletion = Timer.ElapsedMilliseconds();
+    double totalCostOfFlowInWindfarm = windfarm_.ComputeTotalCostOfFlow();
+
+    if (beVerbose_) {
+        verboseStream_  << "Completed Negative Cycle Canceling after "
+                        << millisecondsAtCompletion 
+                        << " milliseconds. The cable layout has a cost of " 
+                        << totalCostOfFlowInWindfarm << "." << std::endl;
+    }
+    doSpecificReporting();
+
+    ReturnCode valueForReturn = (IsTimeLimitExceeded(millisecondsAtCompletion)) ? ReturnCode::TIME_LIMIT : ReturnCode::SUCCESS;
+    logger_.CompleteSummaryWithInformationFromAlgorithmRun(millisecondsAtCompletion, totalCostOfFlowInWindfarm, valueForReturn);
+    return valueForReturn;
+}
+
+ReturnCode NegativeCycleCanceling::RunEpsilonScaledNCC() {
+    double epsilon = settings_.initialEpsilon;
+    for (unsigned int phase = 0; phase < MAXIMUM_NUMBER_OF_EPSILON_PHASES && epsilon >= Auxiliary::DOUBLE_ROUNDING_PRECISION; ++phase, epsilon /= 2) {
+        if (beVerbose_) { verboseStream_ << "\t" << "Cancel cycles with costs below " << -epsilon << " per edge ..." << std::endl; }
+
+        minimumCostDecreasePerEdge_ = epsilon;
+        if (CancelNegativeCyclesForAllDeltas() == ReturnCode::TIME_LIMIT) { break; }
+    }
+    minimumCostDecreasePerEdge_ = 0;
+
+    return IsTimeLimitExceeded() ? ReturnCode::TIME_LIMIT : ReturnCode::SUCCESS;
+}
+
+ReturnCode NegativeCycleCanceling::CancelNegativeCyclesForAllDeltas() {
     int changeOfFlow = deltaStrategy_->FirstDelta();
 
     ReturnCode valueForReturn;
 
     while (!IsTimeLimitExceeded() && deltaStrategy_->Continue(changeOfFlow)) {
+        if (!CanDeltaYieldNegativeCycle(changeOfFlow)) {
+            // Skipping is equivalent to a detection run without a negative cycle
+            if (beVerbose_) { verboseStream_ << "\t" << "Skip delta " << changeOfFlow << " since no edge can have negative residual costs." << std::endl; }
+            changeOfFlow = deltaStrategy_->NextDelta(changeOfFlow, false);
+            continue;
+        }
+
+        if (IsKnownToBeCycleFree(changeOfFlow)) {
+            if (beVerbose_) { verboseStream_ << "\t" << "Skip delta " << changeOfFlow << " since no relevant flow changed after the last unsuccessful detection run." << std::endl; }
+            changeOfFlow = deltaStrategy_->NextDelta(changeOfFlow, false);
+            continue;
+        }
+
         logger_.AnotherNegativeCycleDetectionRunHasStarted();
 
         if (beVerbose_) { verboseStream_ << "\t" << "Compute residual graph for delta " << changeOfFlow << "..." << std::endl; }
 
-        valueForReturn = PerformNegativeCycleCancelingForSingleDelta(logger_, ResidualCostComputer(), changeOfFlow);
+        double solutionCostsBeforeRun = solutionCosts_;
+        double millisecondsBeforeRun = Timer.ElapsedMilliseconds();
+
+        if (settings_.localSearchHops > 0) {
+            valueForReturn = PerformLocalThenGlobalNegativeCycleCanceling(changeOfFlow);
+        } else {
+            valueForReturn = PerformNegativeCycleCancelingForSingleDelta(logger_, ResidualCostComputer(), changeOfFlow);
+        }
 
         if (valueForReturn == ReturnCode::TIME_LIMIT) { break; }
 
+        if (lastDetectionCode_ == ReturnCode::EARLY_TERMINATION && !ResidualCostComputer().HasAdaptedResidualCosts()) {
+            cycleFreeCertificates_.Issue(changeOfFlow);
+        }
+
+        deltaStrategy_->ReportDetectionRun(changeOfFlow,
+                                           solutionCostsBeforeRun - solutionCosts_,
+                                           Timer.ElapsedMilliseconds() - millisecondsBeforeRun);
+
         changeOfFlow = deltaStrategy_->NextDelta(changeOfFlow, valueForReturn == ReturnCode::SUCCESS);
 
         logger_.AnotherNumberOfEdgesHaveBeenRelaxed(detectionStrategy_->NumberOfRelaxedEdgesInLastRun());
     }
 
+    return IsTimeLimitExceeded() ? ReturnCode::TIME_LIMIT : ReturnCode::SUCCESS;
+}
+
+ReturnCode NegativeCycleCanceling::RunDecomposedNCC() {
+    SubstationClusters substationClusters(windfarm_);
+    const std::vector<std::vector<vertexID>>& clusters = substationClusters.Clusters();
+    if (IsTimeLimitExceeded()) { return ReturnCode::TIME_LIMIT; }
+    if (clusters.empty()) { return ReturnCode::NOTHING_CHANGED; }
+
+    if (beVerbose_) { verboseStream_ << "\t" << "Solve " << clusters.size() << " substation clusters in parallel ..." << std::endl; }
+
+    // Each cluster works on its own copy, since flow changes also update shared bookkeeping of the windfarm
+    std::vector<std::unique_ptr<WindfarmResidual>> clusterWindfarms;
+    for (size_t i = 0; i < clusters.size(); ++i) {
+        clusterWindfarms.push_back(std::make_unique<WindfarmResidual>(windfarm_));
+    }
+
+    std::vector<IO::NCCLogger> clusterLoggers(clusters.size());
+    double remainingMilliseconds = maxRunningTimeInMilliseconds_ - Timer.ElapsedMilliseconds();
+    auto SolveCluster = [this, &clusters, &clusterWindfarms, &clusterLoggers, remainingMilliseconds](size_t i) {
+        ClusterNCC clusterNCC(  instance_,
+                                *clusterWindfarms[i],
+                                clusterLoggers[i],
+                                detectionStrategy_->CreateForWindfarm(*clusterWindfarms[i]),
+                                clusters[i],
+                                remainingMilliseconds);
+        clusterNCC.Run();
+    };
+
+    unsigned int numberOfThreads = std::min<unsigned int>(clusters.size(), (settings_.numberOfThreads > 0) ? settings_.numberOfThreads : Auxiliary::ThreadPool::DefaultNumberOfThreads());
+    if (numberOfThreads <= 1) {
+        // E.g., within a portfolio or chain, whose workers already use all threads
+        for (size_t i = 0; i < clusters.size(); ++i) {
+            SolveCluster(i);
+        }
+    } else {
+        Auxiliary::ThreadPool threadPool(numberOfThreads);
+        for (size_t i = 0; i < clusters.size(); ++i) {
+            threadPool.Submit([&SolveCluster, i] { SolveCluster(i); });
+        }
+        threadPool.WaitForAll();
+    }
+
+    for (const IO::NCCLogger& clusterLogger : clusterLoggers) {
+        logger_.AddCountersOf(clusterLogger);
+    }
+
+    // Clusters are disjoint, so each edge within a cluster is only changed by that cluster
+    double solutionCostsBeforeMerge = solutionCosts_;
+    for (size_t i = 0; i < clusters.size(); ++i) {
+        for (vertexID vertex : clusters[i]) {
+            for (edgeID edge : windfarm_.OutgoingEdges(vertex)) {
+                windfarm_.SetFlowOnEdge(edge, clusterWindfarms[i]->FlowOnEdge(edge));
+            }
+        }
+    }
+    solutionCosts_ = windfarm_.ComputeTotalCostOfFlow();
+
 #ifndef NDEBUG
     AssertFeasibleFlow(windfarm_);
 #endif
 
-    double millisecondsAtCompletion = Timer.ElapsedMilliseconds();
-    double totalCostOfFlowInWindfarm = windfarm_.ComputeTotalCostOfFlow();
+    if (beVerbose_) {
+        verboseStream_  << "\t... completed after " << Timer.ElapsedMilliseconds()
+                        << " milliseconds with costs " << solutionCosts_ << ". Run global NCC." << std::endl;
+    }
+    if (IsTimeLimitExceeded()) { return ReturnCode::TIME_LIMIT; }
+    return (solutionCosts_ < solutionCostsBeforeMerge - Auxiliary::DOUBLE_ROUNDING_PRECISION) ? ReturnCode::SUCCESS : ReturnCode::NOTHING_CHANGED;
+}
+
+ReturnCode NegativeCycleCanceling::RunWindowedNCC() {
+    SpatialWindows spatialWindows(windfarm_, settings_.numberOfWindowsPerAxis);
+    if (beVerbose_) { verboseStream_ << "\t" << "Sweep over " << spatialWindows.Windows().size() << " windows ..." << std::endl; }
+
+    bool canceledAnyCycle = false;
+    bool improvedInLastSweep = true;
+    unsigned int numberOfSweeps = 0;
+    while (improvedInLastSweep && !IsTimeLimitExceeded()) {
+        improvedInLastSweep = false;
+        ++numberOfSweeps;
+        for (const std::vector<vertexID>& window : spatialWindows.Windows()) {
+            ReturnCode windowCode = RunNCCforAllDeltasOnWindow(window);
+            if (windowCode == ReturnCode::TIME_LIMIT) { break; }
+            improvedInLastSweep |= (windowCode == ReturnCode::SUCCESS);
+        }
+        canceledAnyCycle |= improvedInLastSweep;
+    }
 
     if (beVerbose_) {
-        verboseStream_  << "Completed Negative Cycle Canceling after "
-                        << millisecondsAtCompletion 
-                        << " milliseconds. The cable layout has a cost of " 
-                        << totalCostOfFlowInWindfarm << "." << std::endl;
+        verboseStream_  << "\t... completed " << numberOfSweeps << " sweeps after "
+                        << Timer.ElapsedMilliseconds() << " milliseconds with costs "
+                        << solutionCosts_ << ". Run global NCC." << std::endl;
     }
-    doSpecificReporting();
+    if (IsTimeLimitExceeded()) { return ReturnCode::TIME_LIMIT; }
+    return canceledAnyCycle ? ReturnCode::SUCCESS : ReturnCode::NOTHING_CHANGED;
+}
 
-    valueForReturn = (IsTimeLimitExceeded(millisecondsAtCompletion)) ? ReturnCode::TIME_LIMIT : ReturnCode::SUCCESS;
-    logger_.CompleteSummaryWithInformationFromAlgorithmRun(millisecondsAtCompletion, totalCostOfFlowInWindfarm, valueForReturn);
-    return valueForReturn;
+ReturnCode NegativeCycleCanceling::RunNCCforAllDeltasOnWindow(const std::vector<vertexID>& window) {
+    bool canceledAnyCycle = false;
+    for (int changeOfFlow = 1; changeOfFlow <= MaximumFlowChange(); ++changeOfFlow) {
+        ReturnCode cancelingCode = ReturnCode::SUCCESS;
+        while (cancelingCode == ReturnCode::SUCCESS && CanDeltaYieldNegativeCycle(changeOfFlow)) {
+            logger_.AnotherNegativeCycleDetectionRunHasStarted();
+
+            if (ResidualCostComputer().HasAdaptedResidualCosts()) {
+                ResidualCostComputer().ComputeResidualCosts(changeOfFlow);
+            } else {
+                ResidualCostComputer().ComputeStandardResidualCostsOnRegion(changeOfFlow, window);
+            }
+            ReturnCode detectionCode = detectionStrategy_->RunOnRegion(window);
+            cancelingCode = CancelDetectedNegativeCycle(logger_, ResidualCostComputer(), changeOfFlow, true, detectionCode);
+
+            logger_.AnotherNumberOfEdgesHaveBeenRelaxed(detectionStrategy_->NumberOfRelaxedEdgesInLastRun());
+
+            if (cancelingCode == ReturnCode::TIME_LIMIT) { return ReturnCode::TIME_LIMIT; }
+            canceledAnyCycle |= (cancelingCode == ReturnCode::SUCCESS);
+        }
+    }
+    return canceledAnyCycle ? ReturnCode::SUCCESS : ReturnCode::NOTHING_CHANGED;
+}
+
+ReturnCode NegativeCycleCanceling::PerformLocalThenGlobalNegativeCycleCanceling(int changeOfFlow) {
+    UpdateLocalDetectionRegion();
+    ResidualCostComputer().ComputeResidualCosts(changeOfFlow);
+    // Only a global run can prove that there is no negative cycle
+    lastDetectionCode_ = ReturnCode::IN_PROGRESS;
+
+    if (!localDetectionRegion_.empty()) {
+        ReturnCode localDetectionCode = detectionStrategy_->RunOnRegion(localDetectionRegion_);
+        ReturnCode localCancelingCode = CancelDetectedNegativeCycle(logger_, ResidualCostComputer(), changeOfFlow, true, localDetectionCode);
+        if (localCancelingCode != ReturnCode::NOTHING_CHANGED) {
+            return localCancelingCode;
+        }
+        if (beVerbose_) { verboseStream_ << "\t" << "No negative cycle in the neighborhood of the last canceled cycles. Run global detection." << std::endl; }
+    }
+
+    // Residual costs are still valid, since no cycle has been canceled
+    ReturnCode detectionCode = detectionStrategy_->Run();
+    lastDetectionCode_ = detectionCode;
+    return CancelDetectedNegativeCycle(logger_, ResidualCostComputer(), changeOfFlow, true, detectionCode);
+}
+
+void NegativeCycleCanceling::UpdateLocalDetectionRegion() {
+    // Without canceled cycles, the flow has not changed anywhere, so there is nothing to search locally
+    if (verticesOnCanceledCycles_.empty()) {
+        localDetectionRegion_.clear();
+        return;
+    }
+
+    localNeighborhood_.Collect(verticesOnCanceledCycles_, settings_.localSearchHops);
+    verticesOnCanceledCycles_.clear();
+
+    // A local run on more than half of the vertices does not save enough to pay for a possible global run afterwards
+    if (2 * localNeighborhood_.Vertices().size() < static_cast<size_t>(windfarm_.NumberOfVertices())) {
+        localDetectionRegion_ = localNeighborhood_.Vertices();
+    } else {
+        localDetectionRegion_.clear();
+    }
 }
 
 double NegativeCycleCanceling::CostOfWalk(WalkIterator begin, WalkIterator end) {
@@ -84,6 +312,27 @@ double NegativeCycleCanceling::CostOfWalk(WalkIterator begin, WalkIterator end)
     return cost;
 }
 
+double NegativeCycleCanceling::RoundingErrorOfWalk(WalkIterator begin, WalkIterator end) {
+#ifdef WCP_COMPACT
+    double error = 0;
+    for (WalkIterator it = begin; it != end; ++it) {
+        error += windfarm_.ResidualCostRoundingErrorOnEdge(*it);
+    }
+    return error;
+#else
+    (void) begin;
+    (void) end;
+    return 0;
+#endif
+}
+
+edgeID NegativeCycleCanceling::EdgeIndexForOutput(edgeID edge) const {
+    const int numberOfOriginalEdges = windfarm_.NumberOfOriginalEdges();
+    if (windfarm_.HasEditedTopology() || edge >= 2 * numberOfOriginalEdges) { return edge; }
+    if (edge < numberOfOriginalEdges) { return instance_.OriginalEdgeIndex(edge); }
+    return numberOfOriginalEdges + instance_.OriginalEdgeIndex(edge - numberOfOriginalEdges);
+}
+
 size_t NegativeCycleCanceling::FindClosingEdge(const std::vector<edgeID>& walk, size_t startIndex) {
     assert(startIndex < walk.size());
     size_t index = startIndex;
@@ -0,0 +1,122 @@
+#include <cassert>
+#include <string>
+
+#include "Algorithms/TopologyEditor.h"
+
+#include "Auxiliary/ReturnCodes.h"
+
+namespace wcp {
+
+namespace Algorithms {
+
+void TopologyEditor::MoveVertex(vertexID vertex, double x, double y) {
+    CheckVertex(vertex);
+    windfarm_.MoveVertex(vertex, x, y);
+}
+
+void TopologyEditor::SetSubstationCapacity(vertexID substation, int capacity) {
+    CheckVertex(substation);
+    if (!windfarm_.IsSubstation(substation)) {
+        throw "Vertex " + std::to_string(substation) + " is no substation.";
+    }
+    if (capacity < 0) {
+        throw std::string("A substation capacity must not be negative.");
+    }
+    windfarm_.SetSubstationCapacity(substation, capacity);
+
+    while (windfarm_.FlowToSubstation(substation) > capacity) {
+        // Take one unit that enters the substation back to the turbine it comes from ...
+        vertexID turbine = INVALID_VERTEX;
+        for (edgeID edge : windfarm_.OutgoingEdges(substation)) {
+            if (windfarm_.FlowOnEdge(edge) < 0) {
+                windfarm_.AddFlowOnEdge(edge, 1);
+                turbine = windfarm_.EndVertex(edge);
+                break;
+            }
+        }
+        assert(turbine != INVALID_VERTEX && windfarm_.IsTurbine(turbine));
+        windfarm_.AddFlowOnEdge(windfarm_.EdgeToSupersubstation(substation), -1);
+
+        // ... and send it to a substation that can still take it.
+        RerouteUnitFrom(turbine);
+    }
+    AssertFeasibleFlow(windfarm_);
+}
+
+edgeID TopologyEditor::AddEdge(vertexID source, vertexID target) {
+    CheckVertex(source);
+    CheckVertex(target);
+    if (source == target) {
+        throw std::string("An edge must not be a loop.");
+    }
+    return windfarm_.AddEdge(source, target);
+}
+
+void TopologyEditor::RemoveEdge(edgeID edge) {
+    if (edge < 0 || edge >= windfarm_.NumberOfOriginalEdges()) {
+        throw "There is no original edge " + std::to_string(edge) + ".";
+    }
+
+    // Orient the edge in the direction of its flow.
+    edgeID edgeWithFlow = (windfarm_.FlowOnEdge(edge) >= 0) ? edge : windfarm_.ReverseEdgeIndex(edge);
+    const vertexID upstreamVertex = windfarm_.StartVertex(edgeWithFlow);
+    const vertexID downstreamVertex = windfarm_.EndVertex(edgeWithFlow);
+    const int flow = windfarm_.FlowOnEdge(edgeWithFlow);
+
+    // The units on the edge no longer arrive downstream ...
+    for (int unit = 0; unit < flow; ++unit) {
+        windfarm_.AddFlowOnEdge(edgeWithFlow, -1);
+        ReleaseUnitTowardsSubstation(downstreamVertex);
+    }
+    windfarm_.RemoveEdge(edge);
+
+    // ... but leave the upstream vertex on other paths.
+    for (int unit = 0; unit < flow; ++unit) {
+        RerouteUnitFrom(upstreamVertex);
+    }
+    AssertFeasibleFlow(windfarm_);
+}
+
+void TopologyEditor::ReleaseUnitTowardsSubstation(vertexID vertex) {
+    // Each step decreases the flow on an edge with positive flow, so this terminates
+    // even if the flow contains cycles.
+    vertexID current = vertex;
+    while (!windfarm_.IsSubstation(current)) {
+        edgeID next = INVALID_EDGE;
+        for (edgeID edge : windfarm_.OutgoingEdges(current)) {
+            if (windfarm_.FlowOnEdge(edge) > 0) {
+                next = edge;
+                break;
+            }
+        }
+        // Flow conservation guarantees an edge with positive flow.
+        assert(next != INVALID_EDGE);
+        windfarm_.AddFlowOnEdge(next, -1);
+        current = windfarm_.EndVertex(next);
+    }
+    windfarm_.AddFlowOnEdge(windfarm_.EdgeToSupersubstation(current), -1);
+}
+
+void TopologyEditor::RerouteUnitFrom(vertexID vertex) {
+    dijkstra_.StartVertex() = vertex;
+    dijkstra_.TargetVertex() = Dijkstra::ANY_FREE_SUBSTATION;
+    if (dijkstra_.Run() != ReturnCode::SUCCESS) {
+        throw "The flow of vertex " + std::to_string(vertex) + " cannot be rerouted to any substation with free capacity.";
+    }
+
+    for (edgeID edge : dijkstra_.ExtractWalk()) {
+        windfarm_.AddFlowOnEdge(edge, 1);
+    }
+    windfarm_.AddFlowOnEdge(windfarm_.EdgeToSupersubstation(dijkstra_.TargetVertex()), 1);
+    ++numberOfReroutedUnits_;
+}
+
+void TopologyEditor::CheckVertex(vertexID vertex) const {
+    if (vertex < 0 || vertex >= windfarm_.NumberOfOriginalVertices()) {
+        throw "There is no turbine or substation " + std::to_string(vertex) + ".";
+    }
+}
+
+} // namespace Algorithms
+
+} // namespace wcp
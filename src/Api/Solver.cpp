@@ -0,0 +1,107 @@
+#include <iostream>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "Api/Solver.h"
+#include "Api/StrategyFactory.h"
+
+#include "DataStructures/Graphs/Vertices/Vertex.h"
+#include "DataStructures/Graphs/WindfarmResidual.h"
+#include "DataStructures/Instance.h"
+
+#include "IO/NCCLogger.h"
+
+namespace wcp {
+
+namespace Api {
+
+/**
+ * Throws a string if graph or options do not describe a valid run.
+ */
+static void CheckInput(const Graph& graph, const SolverOptions& options) {
+    if (graph.vertices.empty()) {
+        throw std::string("The graph has no vertices.");
+    }
+    for (std::size_t vertex = 0; vertex < graph.vertices.size(); ++vertex) {
+        if (graph.vertices[vertex].isSubstation && graph.vertices[vertex].capacity < 0) {
+            throw "Substation " + std::to_string(vertex) + " has a negative capacity.";
+        }
+    }
+    for (std::size_t edge = 0; edge < graph.edges.size(); ++edge) {
+        const Graph::Edge& e = graph.edges[edge];
+        if (e.source < 0 || e.target < 0
+                || e.source >= static_cast<int>(graph.vertices.size())
+                || e.target >= static_cast<int>(graph.vertices.size())) {
+            throw "Edge " + std::to_string(edge) + " has an endpoint that is not a vertex of the graph.";
+        }
+        if (e.source == e.target) {
+            throw "Edge " + std::to_string(edge) + " is a loop.";
+        }
+    }
+    if (graph.cableCapacities.empty() || graph.cableCapacities.size() != graph.cableCosts.size()) {
+        throw std::string("The cable capacities and costs must be non-empty and of equal length.");
+    }
+    if (!options.initialFlow.empty() && options.initialFlow.size() != graph.edges.size()) {
+        throw "The initial flow has " + std::to_string(options.initialFlow.size())
+                + " entries, but the graph has " + std::to_string(graph.edges.size()) + " edges.";
+    }
+}
+
+static void FillInstance(const Graph& graph, DataStructures::Instance& instance) {
+    for (const Graph::Vertex& vertex : graph.vertices) {
+        instance.AddVertex(vertex.x,
+                           vertex.y,
+                           vertex.isSubstation ? DataStructures::VertexType::substation : DataStructures::VertexType::turbine,
+                           vertex.isSubstation ? vertex.capacity : 0);
+    }
+    for (const Graph::Edge& edge : graph.edges) {
+        instance.AddEdge(edge.source, edge.target);
+    }
+
+    instance.UpdateMembers();
+    instance.EnsurePrerequisites();
+}
+
+Result Solve(const Graph& graph, const SolverOptions& options) {
+    CheckInput(graph, options);
+
+    DataStructures::Instance instance(Auxiliary::INFTY,
+                                      Auxiliary::INFTY,
+                                      ogdf::GraphAttributes::nodeGraphics   |
+                                      ogdf::GraphAttributes::nodeLabel      |
+                                      ogdf::GraphAttributes::nodeWeight     |
+                                      ogdf::GraphAttributes::edgeLabel      |
+                                      ogdf::GraphAttributes::edgeIntWeight  |
+                                      ogdf::GraphAttributes::edgeDoubleWeight,
+                                      graph.cableCapacities,
+                                      graph.cableCosts);
+    FillInstance(graph, instance);
+
+    DataStructures::WindfarmResidual windfarm(instance);
+    IO::NCCLogger logger;
+    RunNCC(instance,
+           windfarm,
+           logger,
+           options,
+           ConstructInitializationStrategy(options, windfarm),
+           options.timeLimitInSeconds < Auxiliary::DINFTY ? options.timeLimitInSeconds * 1000 : Auxiliary::DINFTY,
+           false,
+           std::cerr);
+
+    logger.AddMetaToSummary(instance, StrategyNamesOf(options), "NCC");
+
+    Result result;
+    result.status = logger.SummaryRow().Status;
+    result.cost = windfarm.ComputeTotalCostOfFlow();
+    result.flowOnEdges.reserve(windfarm.NumberOfOriginalEdges());
+    for (edgeID edge = 0; edge < windfarm.NumberOfOriginalEdges(); ++edge) {
+        result.flowOnEdges.push_back(windfarm.FlowOnEdge(edge));
+    }
+    result.statistics = logger.SummaryRow();
+    return result;
+}
+
+} // namespace Api
+
+} // namespace wcp
@@ -0,0 +1,162 @@
+#include <utility>
+
+#include "Algorithms/DeltaStrategies/AdaptiveDeltaStrategy.h"
+#include "Algorithms/DeltaStrategies/DecreasingDeltaStrategy.h"
+#include "Algorithms/DeltaStrategies/IncreasingDecreasingStrategy.h"
+#include "Algorithms/DeltaStrategies/IncreasingDeltaStrategy.h"
+#include "Algorithms/DeltaStrategies/RandomDeltaStrategy.h"
+#include "Algorithms/DeltaStrategies/SameNextDeltaStrategy.h"
+
+#include "Algorithms/DetectionStrategies/BellmanFord.h"
+
+#include "Algorithms/Distance/Dijkstra.h"
+#include "Algorithms/Distance/EdgeLength.h"
+#include "Algorithms/Distance/EuclideanLength.h"
+#include "Algorithms/Distance/UnitLength.h"
+
+#include "Algorithms/EscapeStrategies/EscapingBonbons.h"
+#include "Algorithms/EscapeStrategies/EscapingFreeCables.h"
+#include "Algorithms/EscapeStrategies/EscapingLeaves.h"
+
+#include "Algorithms/InitializationStrategies/Collecting.h"
+#include "Algorithms/InitializationStrategies/FlowFromFile.h"
+#include "Algorithms/InitializationStrategies/NonCollecting.h"
+
+#include "Algorithms/EscapingNCC.h"
+#include "Algorithms/SingleRunNCC.h"
+
+#include "Api/StrategyFactory.h"
+
+namespace wcp {
+
+namespace Api {
+
+std::unique_ptr<Algorithms::InitializationStrategy> ConstructInitializationStrategy(const SolverOptions& options, DataStructures::WindfarmResidual& windfarm) {
+    if (!options.initialFlow.empty()) {
+        return std::make_unique<Algorithms::FlowFromFile>(windfarm, options.initialFlow);
+    }
+
+    vertexID targetForInitialization = (options.initializationTarget == TargetSubstation::LAST_FREE)
+                                            ? Algorithms::Dijkstra::LAST_FREE_SUBSTATION
+                                            : Algorithms::Dijkstra::ANY_FREE_SUBSTATION;
+
+    std::unique_ptr<Algorithms::EdgeLength> edgeLengthPointer;
+    if (options.initializationPathLength == PathLength::UNIT) {
+        edgeLengthPointer = std::make_unique<Algorithms::UnitLength>();
+    } else {
+        edgeLengthPointer = std::make_unique<Algorithms::EuclideanLength>();
+    }
+    std::unique_ptr<Algorithms::Dijkstra> dijkstraPointer = std::make_unique<Algorithms::Dijkstra>(windfarm, std::move(edgeLengthPointer));
+
+    if (options.collectingInitialization) {
+        return std::make_unique<Algorithms::Collecting>(windfarm, std::move(dijkstraPointer), targetForInitialization);
+    }
+    return std::make_unique<Algorithms::NonCollecting>(windfarm, std::move(dijkstraPointer), targetForInitialization);
+}
+
+std::unique_ptr<Algorithms::DeltaStrategy> ConstructDeltaStrategy(const SolverOptions& options, const DataStructures::Instance& instance) {
+    int maximumFlowChange = 2 * instance.CableTypes().MaximumCapacity();
+
+    std::unique_ptr<Algorithms::DeltaStrategy> deltaStrategy;
+    switch (options.deltaStrategy) {
+        case DeltaStrategy::INCREASING:
+            deltaStrategy = std::make_unique<Algorithms::IncreasingDeltaStrategy>(maximumFlowChange);
+            break;
+        case DeltaStrategy::DECREASING:
+            deltaStrategy = std::make_unique<Algorithms::DecreasingDeltaStrategy>(maximumFlowChange);
+            break;
+        case DeltaStrategy::INCREASING_DECREASING:
+            deltaStrategy = std::make_unique<Algorithms::IncreasingDecreasingStrategy>(maximumFlowChange);
+            break;
+        case DeltaStrategy::RANDOM:
+            deltaStrategy = std::make_unique<Algorithms::RandomDeltaStrategy>(maximumFlowChange, static_cast<unsigned int>(options.randomSeed));
+            break;
+        case DeltaStrategy::ADAPTIVE:
+            deltaStrategy = std::make_unique<Algorithms::AdaptiveDeltaStrategy>(maximumFlowChange);
+            break;
+    }
+
+    if (options.stayOnSuccessfulDelta) {
+        return std::make_unique<Algorithms::SameNextDeltaStrategy>(std::move(deltaStrategy));
+    }
+    return deltaStrategy;
+}
+
+std::unique_ptr<Algorithms::NegativeCycleDetection> ConstructDetectionStrategy(const SolverOptions& options, DataStructures::WindfarmResidual& windfarm) {
+    if (options.detection == Detection::BELLMAN_FORD) {
+        return std::make_unique<Algorithms::StandardBellmanFord>(windfarm);
+    }
+    return std::make_unique<Algorithms::SideTripFreeBellmanFord>(windfarm);
+}
+
+std::unique_ptr<Algorithms::KeeperOfEscapingStrategies> ConstructEscapingStrategies(const SolverOptions& options, DataStructures::WindfarmResidual& windfarm) {
+    std::unique_ptr<Algorithms::KeeperOfEscapingStrategies> keeperOfEscapingStrategies = std::make_unique<Algorithms::KeeperOfEscapingStrategies>();
+
+    if (options.weightEscapeLeaves > 0) {
+        keeperOfEscapingStrategies->AddEscapingStrategy<Algorithms::EscapingLeaves>(windfarm, options.weightEscapeLeaves);
+    }
+
+    if (options.weightEscapeBonbon > 0) {
+        keeperOfEscapingStrategies->AddEscapingStrategy<Algorithms::EscapingBonbons>(windfarm, options.weightEscapeBonbon);
+    }
+
+    if (options.weightEscapeFreeCables > 0) {
+        keeperOfEscapingStrategies->AddEscapingStrategy<Algorithms::EscapingFreeCables>(windfarm, options.weightEscapeFreeCables);
+    }
+
+    return keeperOfEscapingStrategies;
+}
+
+void RunNCC(DataStructures::Instance& instance,
+            DataStructures::WindfarmResidual& windfarm,
+            IO::NCCLogger& logger,
+            const SolverOptions& options,
+            std::unique_ptr<Algorithms::InitializationStrategy> initializationStrategy,
+            double timeLimitInMilliseconds,
+            bool beVerbose,
+            std::ostream& verboseStream,
+            Algorithms::SharedIncumbent* sharedIncumbent) {
+    std::unique_ptr<Algorithms::DeltaStrategy> deltaStrategy = ConstructDeltaStrategy(options, instance);
+    std::unique_ptr<Algorithms::NegativeCycleDetection> detectionStrategy = ConstructDetectionStrategy(options, windfarm);
+
+    if (options.algorithm == Algorithm::ESCAPING_NCC) {
+        std::unique_ptr<Algorithms::KeeperOfEscapingStrategies> keeperOfEscapingStrategies = ConstructEscapingStrategies(options, windfarm);
+
+        if (!keeperOfEscapingStrategies->AtLeastOneEscapingStrategy()) {
+            throw std::string("No escaping strategies found for Negative Cycle Canceling with Escaping!");
+        }
+        if (beVerbose) {
+            keeperOfEscapingStrategies->OutputInfoOnEscapingStrategies(verboseStream);
+        }
+        Algorithms::EscapingNCC negativeCycleCanceling( instance,
+                                                        windfarm,
+                                                        logger,
+                                                        std::move(initializationStrategy),
+                                                        std::move(deltaStrategy),
+                                                        std::move(detectionStrategy),
+                                                        options.randomSeed,
+                                                        std::move(keeperOfEscapingStrategies),
+                                                        options.iterationLimit,
+                                                        beVerbose,
+                                                        verboseStream,
+                                                        timeLimitInMilliseconds,
+                                                        sharedIncumbent,
+                                                        options.settings);
+    } else {
+        Algorithms::SingleRunNCC negativeCycleCanceling(instance,
+                                                        windfarm,
+                                                        logger,
+                                                        std::move(initializationStrategy),
+                                                        std::move(deltaStrategy),
+                                                        std::move(detectionStrategy),
+                                                        options.randomSeed,
+                                                        beVerbose,
+                                                        verboseStream,
+                                                        timeLimitInMilliseconds,
+                                                        options.settings);
+    }
+}
+
+} // namespace Api
+
+} // namespace wcp
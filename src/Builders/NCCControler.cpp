@@ -1,157 +1,90 @@
+#include <algorithm>
 #include <cassert>
+#include <iostream>
+#include <mutex>
 #include <ostream>
+#include <string>
 #include <vector>
 
-#include "Algorithms/DeltaStrategies/DeltaStrategy.h"
-#include "Algorithms/DeltaStrategies/IncreasingDeltaStrategy.h"
-#include "Algorithms/DeltaStrategies/DecreasingDeltaStrategy.h"
-#include "Algorithms/DeltaStrategies/IncreasingDecreasingStrategy.h"
-#include "Algorithms/DeltaStrategies/RandomDeltaStrategy.h"
-#include "Algorithms/DeltaStrategies/SameNextDeltaStrategy.h"
-
-#include "Algorithms/DetectionStrategies/NegativeCycleDetection.h"
-#include "Algorithms/DetectionStrategies/BellmanFord.h"
-
-#include "Algorithms/Distance/Dijkstra.h"
-#include "Algorithms/Distance/UnitLength.h"
-#include "Algorithms/Distance/EdgeLength.h"
-#include "Algorithms/Distance/EuclideanLength.h"
-
-#include "Algorithms/InitializationStrategies/Collecting.h"
-#include "Algorithms/InitializationStrategies/NonCollecting.h"
+#include "Algorithms/InitializationStrategies/FlowFromFile.h"
 #include "Algorithms/InitializationStrategies/InitializationStrategy.h"
+#include "Algorithms/VertexOrder.h"
 
-#include "Algorithms/EscapeStrategies/KeeperOfEscapingStrategies.h"
-#include "Algorithms/EscapeStrategies/EscapingBonbons.h"
-#include "Algorithms/EscapeStrategies/EscapingFreeCables.h"
-#include "Algorithms/EscapeStrategies/EscapingLeaves.h"
+#include "Api/StrategyFactory.h"
 
-#include "Algorithms/EscapingNCC.h"
-#include "Algorithms/SingleRunNCC.h"
+#include "Auxiliary/ReturnCodes.h"
+#include "Auxiliary/ThreadPool.h"
+#include "Auxiliary/Timer.h"
 
 #include "Builders/NCCControler.h"
+#include "Builders/SolverServer.h"
 
+#include "IO/BatchInput.h"
+#include "IO/InstanceFile.h"
 #include "IO/NCCLogger.h"
+#include "IO/ParserFunctions.h"
 
 namespace wcp {
 
 namespace Builders {
 
-std::unique_ptr<Algorithms::InitializationStrategy> NCCControler::ConstructInitializationStrategy(QString& initializationInputString, Algorithms::WindfarmResidual& windfarm) {
-    try {
-        QString init(initializationInputString);
-        // It should be of form "(COLLECTING)?(DIJKSTRA|BFS)(ANY|LAST)"
-        vertexID targetForInitialization;
-
-        if (initializationInputString.endsWith("ANY")) {
-            targetForInitialization = Algorithms::Dijkstra::ANY_FREE_SUBSTATION;
-            init.chop(3);
-        } else if (init.endsWith("LAST")) {
-            targetForInitialization = Algorithms::Dijkstra::LAST_FREE_SUBSTATION;
-            init.chop(4);
-        } else {
-            throw "Could not identify a suitable initialization strategy from your input '" + initializationInputString.toStdString() 
-                    + "'. Your input must be of format '(COLLECTING)?(DIJKSTRA|BFS)(ANY|LAST)'.";
-        }
-        // Now, init is of form "(COLLECTING)?(DIJKSTRA|BFS)"
-
-        // Decide which edge lengths to use
-        std::unique_ptr<Algorithms::EdgeLength> edgeLengthPointer;
-        if (init.endsWith("BFS")) {
-            edgeLengthPointer = std::make_unique<Algorithms::UnitLength>();
-            init.chop(3);
-        } else if (init.endsWith("DIJKSTRA")) {
-            edgeLengthPointer = std::make_unique<Algorithms::EuclideanLength>();
-            init.chop(8);
-        } else {
-            throw "Could not identify a suitable initialization strategy from your input '" + initializationInputString.toStdString() 
-                    + "'. Your input must be of format '(COLLECTING)?(DIJKSTRA|BFS)(ANY|LAST)'.";
-        }
-        std::unique_ptr<Algorithms::Dijkstra> dijkstraPointer = std::make_unique<Algorithms::Dijkstra>(windfarm, std::move(edgeLengthPointer));
-        // Now, init is of form "(COLLECTING)?"
-
-        if (init == "COLLECTING") {
-            return std::make_unique<Algorithms::Collecting>(windfarm, std::move(dijkstraPointer), targetForInitialization);
-        } else if (init.size() == 0) {
-            return std::make_unique<Algorithms::NonCollecting>(windfarm, std::move(dijkstraPointer), targetForInitialization);
-        } else {
-            throw "Could not identify a suitable initialization strategy from your input '" + initializationInputString.toStdString() 
-                    + "'. Your input must be of format '(COLLECTING)?(DIJKSTRA|BFS)(ANY|LAST)'.";
-        }
-    } catch (const std::string& e) {
-        throw;
+Api::SolverOptions NCCControler::SolverOptionsOf(const DataStructures::InputInformation& inputInformation) {
+    Api::SolverOptions options;
+    options.algorithm = inputInformation.algorithm_.startsWith("ESCAPING") ? Api::Algorithm::ESCAPING_NCC : Api::Algorithm::NCC;
+    // A warm start replaces the initialization, see BuildAndRun.
+    if (!inputInformation.isWarmStartSet_) {
+        Api::ParseInitialization(inputInformation.initialisationStrategy_.toStdString(), options);
     }
+    Api::ParseDeltaStrategy(inputInformation.deltaStrategy_.toStdString(), options);
+    Api::ParseDetection(inputInformation.detectionStrategy_.toStdString(), options);
+
+    options.randomSeed = inputInformation.randomSeed_;
+    options.iterationLimit = inputInformation.iterationLimit_;
+    options.weightEscapeLeaves = inputInformation.weightEscapeLeaves_;
+    options.weightEscapeBonbon = inputInformation.weightEscapeBonbon_;
+    options.weightEscapeFreeCables = inputInformation.weightEscapeFreeCables_;
+    options.settings = ConstructNCCSettings(inputInformation);
+    return options;
 }
 
-std::unique_ptr<Algorithms::DeltaStrategy> NCCControler::ConstructDeltaStrategy(QString& deltaInputString, int seedInput, DataStructures::Instance& instance) {
-    try {
-        QString delta(deltaInputString);
-        // should be of form "*(STAY)?(INC|DEC|INCDEC|RANDOM)"
-        int maximumFlowChange = 2 * instance.CableTypes().MaximumCapacity();
-
-        std::unique_ptr<Algorithms::DeltaStrategy> auxiliaryDeltaStrategy_;
-        if (delta.endsWith("INC")) {
-            auxiliaryDeltaStrategy_ = std::make_unique<Algorithms::IncreasingDeltaStrategy>(maximumFlowChange);
-            delta.chop(3);
-        } else if (delta.endsWith("DEC") && !delta.endsWith("INCDEC")) {
-            auxiliaryDeltaStrategy_ = std::make_unique<Algorithms::DecreasingDeltaStrategy>(maximumFlowChange);
-            delta.chop(3);
-        } else if (delta.endsWith("INCDEC")) {
-            auxiliaryDeltaStrategy_ = std::make_unique<Algorithms::IncreasingDecreasingStrategy>(maximumFlowChange);
-            delta.chop(6);
-        } else if (delta.endsWith("RANDOM")) {
-            unsigned int seed = static_cast<unsigned int>( seedInput );
-            auxiliaryDeltaStrategy_ = std::make_unique<Algorithms::RandomDeltaStrategy>(maximumFlowChange, seed);
-            delta.chop(6);
-        } else {
-            throw "Could not identify a suitable delta strategy from your input '" + deltaInputString.toStdString()
-                    + "'. Your input must be of the form '(STAY)?(INC|DEC|INCDEC|RANDOM)'.";
-        }
-
-        if (delta == "STAY") {
-            return std::make_unique<Algorithms::SameNextDeltaStrategy>(std::move(auxiliaryDeltaStrategy_));
-        } else if (delta.size() == 0) {
-            return auxiliaryDeltaStrategy_;
-        } else {
-            throw "Could not identify a suitable delta strategy from your input '" + deltaInputString.toStdString()
-                    + "'. Your input must be of the form '(STAY)?(INC|DEC|INCDEC|RANDOM)'.";
-        }
-    } catch (const std::string& e) {
-        throw;
+Algorithms::NCCSettings NCCControler::ConstructNCCSettings(const DataStructures::InputInformation& inputInformation) {
+    Algorithms::NCCSettings settings;
+    settings.localSearchHops = inputInformation.localSearchHops_;
+    settings.numberOfWindowsPerAxis = inputInformation.numberOfWindowsPerAxis_;
+    settings.decomposeBySubstations = inputInformation.decomposeBySubstations_;
+    settings.numberOfThreads = inputInformation.numberOfThreads_;
+    settings.initialEpsilon = inputInformation.initialEpsilon_;
+    settings.incumbentStream = incumbentStream_.get();
+    if (inputInformation.isCheckpointSet_) {
+        settings.checkpointFile = inputInformation.checkpointFile_.toStdString();
+        settings.checkpointIntervalInMilliseconds = inputInformation.checkpointIntervalInSeconds_ * 1000;
     }
-}
-
-std::unique_ptr<Algorithms::NegativeCycleDetection> NCCControler::ConstructDetectionStrategy(QString& detectionInputString, Algorithms::WindfarmResidual& windfarm) {
-    try {
-        if (detectionInputString == "STFBF") {
-            return std::make_unique<Algorithms::SideTripFreeBellmanFord>(windfarm);
-        } else if (detectionInputString == "BF") {
-            return std::make_unique<Algorithms::StandardBellmanFord>(windfarm);
-        } else {
-            throw "Could not identify a suitable detection strategy from your input '" + detectionInputString.toStdString()
-                    + "'. Your input must be 'BF' or 'STFBF'.";
-        }
-    } catch (const std::string& e) {
-        throw;
+    if (inputInformation.isResumeSet_) {
+        settings.resumeFile = inputInformation.resumeFile_.toStdString();
     }
+    return settings;
 }
 
-std::unique_ptr<Algorithms::KeeperOfEscapingStrategies> NCCControler::ConstructEscapingStrategies(DataStructures::InputInformation& inputInformation, Algorithms::WindfarmResidual& windfarm) {
-    std::unique_ptr<Algorithms::KeeperOfEscapingStrategies> keeperOfEscapingStrategies = std::make_unique<Algorithms::KeeperOfEscapingStrategies>();
+void NCCControler::SetUpIncumbentStream(const DataStructures::Instance& instance, const DataStructures::InputInformation& inputInformation) {
+    if (!inputInformation.isIncumbentStreamSet_) { return; }
 
-    if (inputInformation.weightEscapeLeaves_ > 0) {
-        keeperOfEscapingStrategies->AddEscapingStrategy<Algorithms::EscapingLeaves>(windfarm, inputInformation.weightEscapeLeaves_);
-    }
-
-    if (inputInformation.weightEscapeBonbon_ > 0) {
-        keeperOfEscapingStrategies->AddEscapingStrategy<Algorithms::EscapingBonbons>(windfarm, inputInformation.weightEscapeBonbon_);
+    std::ostream* os = &std::cout;
+    if (inputInformation.incumbentStreamFile_ != "-") {
+        incumbentStreamFile_ = std::make_unique<std::ofstream>(inputInformation.incumbentStreamFile_.toStdString());
+        if (!incumbentStreamFile_->is_open()) {
+            throw "Could not open file '" + inputInformation.incumbentStreamFile_.toStdString() + "' for streaming.";
+        }
+        os = incumbentStreamFile_.get();
     }
-
-    if (inputInformation.weightEscapeFreeCables_ > 0) {
-        keeperOfEscapingStrategies->AddEscapingStrategy<Algorithms::EscapingFreeCables>(windfarm, inputInformation.weightEscapeFreeCables_);
+    std::vector<edgeID> originalIndexOfEdge;
+    if (instance.IsRenumbered()) {
+        for (edgeID edge = 0; edge < instance.NumberOfEdges(); ++edge) {
+            originalIndexOfEdge.push_back(instance.OriginalEdgeIndex(edge));
+        }
     }
-
-    return keeperOfEscapingStrategies;
+    incumbentStream_ = std::make_unique<IO::IncumbentStream>(IO::IncumbentStream::JsonLinesWriter(*os, originalIndexOfEdge),
+                                                             inputInformation.incumbentStreamIntervalInMilliseconds_,
+                                                             inputInformation.streamFlowChanges_);
 }
 
 double NCCControler::DetermineAndOutputTimeLimit(DataStructures::InputInformation& inputInformation, const DataStructures::OutputInformation& outputInformation) {
@@ -191,53 +124,356 @@ void NCCControler::BuildAndRunAndOutput(DataStructures::Instance& instance,
                                         const DataStructures::OutputInformation& outputInformation) {
     assert(inputInformation.algorithm_.endsWith("NCC"));
 
+    if ((inputInformation.isCheckpointSet_ || inputInformation.isResumeSet_)
+            && (!inputInformation.algorithm_.startsWith("ESCAPING") || inputInformation.isPortfolioSet_ || inputInformation.numberOfChains_ > 1)) {
+        throw std::string("Checkpoints are only supported for a single chain of EscapingNCC.");
+    }
+
+    SetUpIncumbentStream(instance, inputInformation);
+
+    if (inputInformation.isPortfolioSet_) {
+        BuildAndRunPortfolioAndOutput(instance, inputInformation, outputInformation);
+        return;
+    }
+
+    if (inputInformation.numberOfChains_ > 1 && inputInformation.algorithm_.startsWith("ESCAPING")) {
+        BuildAndRunChainsAndOutput(instance, inputInformation, outputInformation);
+        return;
+    }
+
     Algorithms::WindfarmResidual windfarm(instance);
 
     double timeLimitInMilliseconds = DetermineAndOutputTimeLimit(inputInformation, outputInformation);
+    if (inputInformation.algorithm_.startsWith("ESCAPING")) {
+        OutputIterationLimit(inputInformation, outputInformation);
+    }
 
     IO::NCCLogger logger;
 
-    std::unique_ptr<Algorithms::InitializationStrategy> initializationStrategy = ConstructInitializationStrategy(inputInformation.initialisationStrategy_, windfarm);
-    std::unique_ptr<Algorithms::DeltaStrategy> deltaStrategy = ConstructDeltaStrategy(inputInformation.deltaStrategy_, inputInformation.randomSeed_, instance);
-    std::unique_ptr<Algorithms::NegativeCycleDetection> detectionStrategy = ConstructDetectionStrategy(inputInformation.detectionStrategy_, windfarm);
+    BuildAndRun(instance,
+                windfarm,
+                logger,
+                inputInformation,
+                timeLimitInMilliseconds,
+                outputInformation.ShouldBeVerbose(),
+                outputInformation.VerboseStream());
+
+    logger.CompleteOutput(instance, inputInformation.Strategies(), outputInformation, windfarm, "NCC");
+}
+
+void NCCControler::BuildAndRun( DataStructures::Instance& instance,
+                                Algorithms::WindfarmResidual& windfarm,
+                                IO::NCCLogger& logger,
+                                DataStructures::InputInformation& inputInformation,
+                                double timeLimitInMilliseconds,
+                                bool beVerbose,
+                                std::ostream& verboseStream,
+                                Algorithms::SharedIncumbent* sharedIncumbent,
+                                IO::IncumbentStream* incumbentStream) {
+    Api::SolverOptions options = SolverOptionsOf(inputInformation);
+    if (inputInformation.isWarmStartSet_) {
+        options.initialFlow = instance.FromOriginalEdgeOrder(IO::FlowFile::Read(inputInformation.warmStartFile_.toStdString()));
+    }
+    std::unique_ptr<Algorithms::InitializationStrategy> initializationStrategy = Api::ConstructInitializationStrategy(options, windfarm);
+    RunWithInitialization(  instance,
+                            windfarm,
+                            logger,
+                            inputInformation,
+                            std::move(initializationStrategy),
+                            timeLimitInMilliseconds,
+                            beVerbose,
+                            verboseStream,
+                            sharedIncumbent,
+                            incumbentStream);
+}
+
+void NCCControler::Reoptimize(  DataStructures::Instance& instance,
+                                Algorithms::WindfarmResidual& windfarm,
+                                IO::NCCLogger& logger,
+                                DataStructures::InputInformation& inputInformation,
+                                double timeLimitInMilliseconds,
+                                bool beVerbose,
+                                std::ostream& verboseStream) {
+    std::vector<int> flowOnOriginalEdges;
+    flowOnOriginalEdges.reserve(windfarm.NumberOfOriginalEdges());
+    for (edgeID edge = 0; edge < windfarm.NumberOfOriginalEdges(); ++edge) {
+        flowOnOriginalEdges.push_back(windfarm.FlowOnEdge(edge));
+    }
+    // NCC starts from zero flow and sets the current flow again as its initial flow.
+    windfarm.ClearFlow();
+    RunWithInitialization(  instance,
+                            windfarm,
+                            logger,
+                            inputInformation,
+                            std::make_unique<Algorithms::FlowFromFile>(windfarm, std::move(flowOnOriginalEdges)),
+                            timeLimitInMilliseconds,
+                            beVerbose,
+                            verboseStream,
+                            nullptr,
+                            nullptr);
+}
+
+void NCCControler::RunWithInitialization(   DataStructures::Instance& instance,
+                                            Algorithms::WindfarmResidual& windfarm,
+                                            IO::NCCLogger& logger,
+                                            DataStructures::InputInformation& inputInformation,
+                                            std::unique_ptr<Algorithms::InitializationStrategy> initializationStrategy,
+                                            double timeLimitInMilliseconds,
+                                            bool beVerbose,
+                                            std::ostream& verboseStream,
+                                            Algorithms::SharedIncumbent* sharedIncumbent,
+                                            IO::IncumbentStream* incumbentStream) {
+    Api::SolverOptions options = SolverOptionsOf(inputInformation);
+    if (incumbentStream != nullptr) {
+        options.settings.incumbentStream = incumbentStream;
+    }
+    Api::RunNCC(instance,
+                windfarm,
+                logger,
+                options,
+                std::move(initializationStrategy),
+                timeLimitInMilliseconds,
+                beVerbose,
+                verboseStream,
+                sharedIncumbent);
+}
+
+void NCCControler::BuildAndRunPortfolioAndOutput(   DataStructures::Instance& instance,
+                                                    DataStructures::InputInformation& inputInformation,
+                                                    const DataStructures::OutputInformation& outputInformation) {
+    std::vector<DataStructures::InputInformation> combinations = ParsePortfolio(inputInformation, inputInformation.portfolio_);
+
+    // Each combination works on its own flow, but all of them share the read-only instance and topology.
+    const Algorithms::WindfarmResidual windfarm(instance);
+    std::vector<std::unique_ptr<ParallelNCCRun>> runs;
+    for (const DataStructures::InputInformation& combination : combinations) {
+        runs.push_back(std::make_unique<ParallelNCCRun>(windfarm, combination));
+    }
+
+    if (outputInformation.ShouldBeVerbose()) {
+        outputInformation.VerboseStream() << "Run a portfolio of " << runs.size() << " strategy combinations.\n";
+    }
+
+    RunInParallelAndOutputBest(instance, runs, inputInformation, outputInformation, nullptr);
+}
+
+void NCCControler::BuildAndRunChainsAndOutput(  DataStructures::Instance& instance,
+                                                DataStructures::InputInformation& inputInformation,
+                                                const DataStructures::OutputInformation& outputInformation) {
+    const Algorithms::WindfarmResidual windfarm(instance);
+    std::vector<std::unique_ptr<ParallelNCCRun>> runs;
+    for (unsigned int chain = 0; chain < inputInformation.numberOfChains_; ++chain) {
+        DataStructures::InputInformation inputOfChain(inputInformation);
+        inputOfChain.randomSeed_ = inputInformation.randomSeed_ + static_cast<int>(chain);
+        runs.push_back(std::make_unique<ParallelNCCRun>(windfarm, inputOfChain));
+    }
+
+    if (outputInformation.ShouldBeVerbose()) {
+        outputInformation.VerboseStream() << "Run " << runs.size() << " chains of " << inputInformation.algorithmStdString_
+                                          << " with seeds " << inputInformation.randomSeed_
+                                          << " to " << runs.back()->inputInformation.randomSeed_ << ".\n";
+    }
+
+    Algorithms::SharedIncumbent sharedIncumbent;
+    RunInParallelAndOutputBest(instance, runs, inputInformation, outputInformation, &sharedIncumbent);
+}
+
+void NCCControler::RunInParallelAndOutputBest(  DataStructures::Instance& instance,
+                                                std::vector<std::unique_ptr<ParallelNCCRun>>& runs,
+                                                DataStructures::InputInformation& inputInformation,
+                                                const DataStructures::OutputInformation& outputInformation,
+                                                Algorithms::SharedIncumbent* sharedIncumbent) {
+    assert(!runs.empty());
+
+    double timeLimitInMilliseconds = DetermineAndOutputTimeLimit(inputInformation, outputInformation);
     if (inputInformation.algorithm_.startsWith("ESCAPING")) {
         OutputIterationLimit(inputInformation, outputInformation);
+    }
 
-        std::unique_ptr<Algorithms::KeeperOfEscapingStrategies> keeperOfEscapingStrategies = ConstructEscapingStrategies(inputInformation, windfarm);
+    unsigned int numberOfThreads = inputInformation.numberOfThreads_;
+    if (numberOfThreads == 0) {
+        numberOfThreads = Auxiliary::ThreadPool::DefaultNumberOfThreads();
+    }
+    numberOfThreads = std::min(numberOfThreads, static_cast<unsigned int>(runs.size()));
 
-        if (keeperOfEscapingStrategies->AtLeastOneEscapingStrategy()) {
-            if (outputInformation.ShouldBeVerbose()) {
-                keeperOfEscapingStrategies->OutputInfoOnEscapingStrategies(outputInformation.VerboseStream());
-            }
-            Algorithms::EscapingNCC negativeCycleCanceling( instance,
-                                                            windfarm,
-                                                            logger,
-                                                            std::move(initializationStrategy),
-                                                            std::move(deltaStrategy),
-                                                            std::move(detectionStrategy),
-                                                            inputInformation.randomSeed_,
-                                                            std::move(keeperOfEscapingStrategies),
-                                                            inputInformation.iterationLimit_,
-                                                            outputInformation.ShouldBeVerbose(),
-                                                            outputInformation.VerboseStream(),
-                                                            timeLimitInMilliseconds);
-        } else {
-            throw std::string("No escaping strategies found for Negative Cycle Canceling with Escaping!");
+    if (outputInformation.ShouldBeVerbose()) {
+        outputInformation.VerboseStream() << "Use " << numberOfThreads << " threads.\n";
+    }
+
+    Auxiliary::Timer parallelTimer;
+    {
+        Auxiliary::ThreadPool threadPool(numberOfThreads);
+        for (std::unique_ptr<ParallelNCCRun>& run : runs) {
+            ParallelNCCRun* currentRun = run.get();
+            threadPool.Submit([this, &instance, &parallelTimer, timeLimitInMilliseconds, sharedIncumbent, currentRun] {
+                // The time limit is shared: a run that has to wait for a free thread only gets the remaining time.
+                double remainingMilliseconds = timeLimitInMilliseconds - parallelTimer.ElapsedMilliseconds();
+                if (remainingMilliseconds <= 0) {
+                    currentRun->logger.SummaryRow().Status = ReturnCode::TIME_LIMIT;
+                    return;
+                }
+                BuildAndRun(instance,
+                            currentRun->windfarm,
+                            currentRun->logger,
+                            currentRun->inputInformation,
+                            remainingMilliseconds,
+                            false,
+                            std::cout,
+                            sharedIncumbent);
+            });
+        }
+        threadPool.WaitForAll();
+    }
+
+    ParallelNCCRun* bestRun = runs.front().get();
+    for (std::unique_ptr<ParallelNCCRun>& run : runs) {
+        if (outputInformation.ShouldBeVerbose()) {
+            outputInformation.VerboseStream() << "Run " << run->inputInformation.initialisationStrategy_.toStdString()
+                                              << ":" << run->inputInformation.deltaStrategy_.toStdString()
+                                              << ":" << run->inputInformation.detectionStrategy_.toStdString()
+                                              << " with seed " << run->inputInformation.randomSeed_
+                                              << " terminated with status " << run->logger.SummaryRow().Status
+                                              << " and best solution " << run->logger.SummaryRow().BestSolution << ".\n";
+        }
+        if (run->logger.SummaryRow().BestSolution < bestRun->logger.SummaryRow().BestSolution) {
+            bestRun = run.get();
         }
+    }
+
+    bestRun->logger.CompleteOutput(instance, bestRun->inputInformation.Strategies(), outputInformation, bestRun->windfarm, "NCC");
+}
+
+void NCCControler::BuildAndRunBatchAndOutput(  DataStructures::InputInformation& inputInformation,
+                                                const DataStructures::OutputInformation& outputInformation) {
+    assert(inputInformation.algorithm_.endsWith("NCC"));
+    if (inputInformation.isPortfolioSet_ || inputInformation.numberOfChains_ > 1 || inputInformation.isIncumbentStreamSet_
+            || inputInformation.isCheckpointSet_ || inputInformation.isResumeSet_ || inputInformation.isWarmStartSet_) {
+        // A single warm start flow fits at most one of the instances of the batch
+        throw std::string("Batch mode cannot be combined with --portfolio, --chains, --stream, --checkpoint, --resume or --warmStart.");
+    }
+
+    const std::vector<std::string> instanceFiles = IO::ListInstanceFiles(inputInformation.batchInput_);
+
+    std::vector<DataStructures::InputInformation> combinations;
+    if (inputInformation.isGridSet_) {
+        combinations = ParsePortfolio(inputInformation, inputInformation.grid_);
+    } else {
+        combinations.push_back(inputInformation);
+    }
+
+    double timeLimitInMilliseconds = DetermineAndOutputTimeLimit(inputInformation, outputInformation);
+    if (inputInformation.algorithm_.startsWith("ESCAPING")) {
+        OutputIterationLimit(inputInformation, outputInformation);
+    }
+
+    unsigned int numberOfThreads = inputInformation.numberOfThreads_;
+    if (numberOfThreads == 0) {
+        numberOfThreads = Auxiliary::ThreadPool::DefaultNumberOfThreads();
+    }
+    numberOfThreads = std::min(numberOfThreads, static_cast<unsigned int>(instanceFiles.size()));
+
+    if (outputInformation.ShouldBeVerbose()) {
+        outputInformation.VerboseStream() << "Solve " << instanceFiles.size() << " instances with "
+                                          << combinations.size() << " strategy combinations each on "
+                                          << numberOfThreads << " threads.\n";
+    }
+
+    // Output from all threads goes to the same files and streams.
+    std::mutex outputMutex;
+    Auxiliary::ThreadPool threadPool(numberOfThreads);
+    for (const std::string& instanceFile : instanceFiles) {
+        threadPool.Submit([this, &combinations, &outputInformation, &outputMutex, timeLimitInMilliseconds, instanceFile] {
+            try {
+                RunBatchInstance(instanceFile, combinations, timeLimitInMilliseconds, outputInformation, outputMutex);
+            } catch (const std::string& message) {
+                // A broken instance should not stop the whole batch.
+                std::lock_guard<std::mutex> lock(outputMutex);
+                std::cerr << "Skip instance '" << instanceFile << "': " << message << std::endl;
+            }
+        });
+    }
+    threadPool.WaitForAll();
+}
+
+void NCCControler::RunBatchInstance(const std::string& instanceFile,
+                                    const std::vector<DataStructures::InputInformation>& combinations,
+                                    double timeLimitInMilliseconds,
+                                    const DataStructures::OutputInformation& outputInformation,
+                                    std::mutex& outputMutex) {
+    DataStructures::InputInformation inputOfInstance(combinations.front());
+    IO::SetInputFile(QString::fromStdString(instanceFile), inputOfInstance);
+
+    DataStructures::Instance instance(inputOfInstance.testsetNumber_, inputOfInstance.instanceNumber_);
+    IO::ReadInstanceFromFile(instanceFile, instance, inputOfInstance.useOGDFReader_);
+    Algorithms::RenumberInstance(instance, inputOfInstance.vertexOrder_.toStdString());
+
+    Algorithms::WindfarmResidual windfarm(instance);
+    for (const DataStructures::InputInformation& combination : combinations) {
+        DataStructures::InputInformation inputOfRun(combination);
+        inputOfRun.inputfile_ = inputOfInstance.inputfile_;
+        inputOfRun.testsetNumber_ = inputOfInstance.testsetNumber_;
+        inputOfRun.instanceNumber_ = inputOfInstance.instanceNumber_;
+        // The instances of the batch already occupy all threads
+        inputOfRun.numberOfThreads_ = 1;
+
+        windfarm.ClearFlow();
+        IO::NCCLogger logger;
+        BuildAndRun(instance,
+                    windfarm,
+                    logger,
+                    inputOfRun,
+                    timeLimitInMilliseconds,
+                    false,
+                    std::cout);
+
+        std::lock_guard<std::mutex> lock(outputMutex);
+        logger.CompleteOutput(instance, inputOfRun.Strategies(), outputInformation, windfarm, "NCC");
+    }
+}
+
+void NCCControler::Serve(   DataStructures::InputInformation& inputInformation,
+                            const DataStructures::OutputInformation& outputInformation) {
+    assert(inputInformation.algorithm_.endsWith("NCC"));
+    if (inputInformation.isPortfolioSet_ || inputInformation.numberOfChains_ > 1 || inputInformation.isIncumbentStreamSet_
+            || inputInformation.isCheckpointSet_ || inputInformation.isResumeSet_ || inputInformation.isWarmStartSet_) {
+        throw std::string("The server cannot be combined with --portfolio, --chains, --stream, --checkpoint, --resume or --warmStart.");
+    }
+
+    SolverServer server(*this, inputInformation);
+    if (inputInformation.serverSocket_.isEmpty()) {
+        server.ServeStandardStreams();
     } else {
-        Algorithms::SingleRunNCC negativeCycleCanceling(instance,
-                                                        windfarm,
-                                                        logger,
-                                                        std::move(initializationStrategy),
-                                                        std::move(deltaStrategy),
-                                                        std::move(detectionStrategy),
-                                                        inputInformation.randomSeed_,
-                                                        outputInformation.ShouldBeVerbose(),
-                                                        outputInformation.VerboseStream(),
-                                                        timeLimitInMilliseconds);
-    }
-
-    logger.CompleteOutput(instance, inputInformation, outputInformation, windfarm, "NCC");
+        if (outputInformation.ShouldBeVerbose()) {
+            outputInformation.VerboseStream() << "Listen on socket '" << inputInformation.serverSocket_.toStdString() << "'." << std::endl;
+        }
+        server.ServeUnixSocket(inputInformation.serverSocket_.toStdString());
+    }
+}
+
+std::vector<DataStructures::InputInformation> NCCControler::ParsePortfolio(const DataStructures::InputInformation& inputInformation, const QString& portfolio) {
+    std::vector<DataStructures::InputInformation> combinations;
+
+    const QStringList combinationStrings = portfolio.split(",");
+    for (const QString& combinationString : combinationStrings) {
+        if (combinationString.trimmed().isEmpty()) { continue; }
+
+        const QStringList strategies = combinationString.trimmed().split(":");
+        if (strategies.size() != 3) {
+            throw "Could not identify a strategy combination from your input '" + combinationString.toStdString()
+                    + "'. Each combination must be of the form 'INIT:DELTA:DETECT'.";
+        }
+
+        DataStructures::InputInformation combination(inputInformation);
+        combination.initialisationStrategy_ = strategies[0].trimmed().toUpper();
+        combination.deltaStrategy_ = strategies[1].trimmed().toUpper();
+        combination.detectionStrategy_ = strategies[2].trimmed().toUpper();
+        combinations.push_back(combination);
+    }
+
+    if (combinations.empty()) {
+        throw "The input '" + portfolio.toStdString() + "' does not contain any strategy combination.";
+    }
+    return combinations;
 }
 
 
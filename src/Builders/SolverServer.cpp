@@ -0,0 +1,316 @@
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <iterator>
+#include <sstream>
+#include <utility>
+
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "Builders/SolverServer.h"
+#include "Builders/NCCControler.h"
+
+#include "Auxiliary/CancellationToken.h"
+#include "Auxiliary/Constants.h"
+#include "Auxiliary/Timer.h"
+
+#include "IO/GMLReader.h"
+#include "IO/IncumbentStream.h"
+#include "IO/NCCLogger.h"
+#include "IO/ParserFunctions.h"
+
+namespace wcp {
+
+namespace Builders {
+
+/**
+ * Reads lines from a file descriptor. Waits with poll, so that a signal ends
+ * the input even while no client writes anything.
+ */
+class LineReader {
+public:
+    LineReader(int fileDescriptor, int pollIntervalInMilliseconds)
+      : fileDescriptor_(fileDescriptor),
+        pollIntervalInMilliseconds_(pollIntervalInMilliseconds),
+        isAtEnd_(false) {}
+
+    /**
+     * Returns false at the end of the input or if the process received SIGINT or SIGTERM.
+     */
+    bool ReadLine(std::string& line) {
+        while (true) {
+            std::size_t endOfLine = buffer_.find('\n');
+            if (endOfLine != std::string::npos) {
+                line = buffer_.substr(0, endOfLine);
+                buffer_.erase(0, endOfLine + 1);
+                return true;
+            }
+            if (isAtEnd_) {
+                if (buffer_.empty()) { return false; }
+                line.swap(buffer_);
+                buffer_.clear();
+                return true;
+            }
+            if (Auxiliary::CancellationToken::HasReceivedSignal()) { return false; }
+
+            pollfd descriptor = {fileDescriptor_, POLLIN, 0};
+            int numberOfReadyDescriptors = poll(&descriptor, 1, pollIntervalInMilliseconds_);
+            if (numberOfReadyDescriptors == 0 || (numberOfReadyDescriptors < 0 && errno == EINTR)) { continue; }
+            if (numberOfReadyDescriptors < 0) {
+                isAtEnd_ = true;
+                continue;
+            }
+
+            char chunk[4096];
+            ssize_t numberOfBytes = read(fileDescriptor_, chunk, sizeof(chunk));
+            if (numberOfBytes < 0 && errno == EINTR) { continue; }
+            if (numberOfBytes <= 0) {
+                isAtEnd_ = true;
+                continue;
+            }
+            buffer_.append(chunk, numberOfBytes);
+        }
+    }
+
+private:
+    int fileDescriptor_;
+    int pollIntervalInMilliseconds_;
+    std::string buffer_;
+    bool isAtEnd_;
+};
+
+/**
+ * Writes all of text unless the other side has gone away.
+ */
+static void WriteToFileDescriptor(int fileDescriptor, const std::string& text) {
+    std::size_t numberOfWrittenBytes = 0;
+    while (numberOfWrittenBytes < text.size()) {
+        ssize_t numberOfBytes = write(fileDescriptor, text.data() + numberOfWrittenBytes, text.size() - numberOfWrittenBytes);
+        if (numberOfBytes < 0) {
+            if (errno == EINTR) { continue; }
+            return;
+        }
+        numberOfWrittenBytes += numberOfBytes;
+    }
+}
+
+SolverServer::SolverServer(NCCControler& controler, const DataStructures::InputInformation& defaults)
+  : controler_(controler),
+    defaults_(defaults),
+    threadPool_(defaults.numberOfThreads_),
+    numberOfCachedInstances_(0) {}
+
+void SolverServer::ServeStandardStreams() {
+    std::cout.flush();
+    ServeFileDescriptors(STDIN_FILENO, STDOUT_FILENO);
+}
+
+void SolverServer::ServeUnixSocket(const std::string& socketPath) {
+    sockaddr_un address;
+    std::memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (socketPath.size() >= sizeof(address.sun_path)) {
+        throw "The socket path '" + socketPath + "' is too long.";
+    }
+    std::strncpy(address.sun_path, socketPath.c_str(), sizeof(address.sun_path) - 1);
+
+    int listeningSocket = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listeningSocket < 0) {
+        throw std::string("Could not create a socket.");
+    }
+    // A client that disconnects early must not kill the server.
+    std::signal(SIGPIPE, SIG_IGN);
+    unlink(socketPath.c_str());
+    if (bind(listeningSocket, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0
+            || listen(listeningSocket, 16) < 0) {
+        close(listeningSocket);
+        throw "Could not listen on socket '" + socketPath + "'.";
+    }
+
+    while (!Auxiliary::CancellationToken::HasReceivedSignal()) {
+        pollfd descriptor = {listeningSocket, POLLIN, 0};
+        if (poll(&descriptor, 1, POLL_INTERVAL_IN_MILLISECONDS) <= 0) { continue; }
+
+        int connection = accept(listeningSocket, nullptr, nullptr);
+        if (connection < 0) { continue; }
+        ServeFileDescriptors(connection, connection);
+        close(connection);
+    }
+
+    close(listeningSocket);
+    unlink(socketPath.c_str());
+}
+
+void SolverServer::ServeFileDescriptors(int inputDescriptor, int outputDescriptor) {
+    std::mutex outputMutex;
+    const LineWriter writeLine = [outputDescriptor, &outputMutex](const std::string& line) {
+        std::lock_guard<std::mutex> lock(outputMutex);
+        WriteToFileDescriptor(outputDescriptor, line);
+    };
+
+    LineReader reader(inputDescriptor, POLL_INTERVAL_IN_MILLISECONDS);
+    std::string line;
+    while (reader.ReadLine(line)) {
+        if (line.find_first_not_of(" \t\r") == std::string::npos) { continue; }
+        threadPool_.Submit([this, line, &writeLine] { HandleRequest(line, writeLine); });
+    }
+    // writeLine must outlive all requests of this input.
+    threadPool_.WaitForAll();
+}
+
+void SolverServer::HandleRequest(const std::string& line, const LineWriter& writeLine) {
+    IO::ServerProtocol::Request request;
+    try {
+        DataStructures::InputInformation inputInformation(defaults_);
+        IO::ServerProtocol::ParseRequest(line, request, inputInformation);
+        // Requests are already solved in parallel, so subproblems of a request are solved on its own thread
+        inputInformation.numberOfThreads_ = 1;
+
+        Auxiliary::Timer timer;
+        bool wasInstanceCached = false;
+        std::shared_ptr<CachedInstance> cachedInstance = LoadInstance(request, wasInstanceCached);
+        inputInformation.testsetNumber_ = cachedInstance->instance->TestsetNumber();
+        inputInformation.instanceNumber_ = cachedInstance->instance->InstanceNumber();
+
+        std::unique_ptr<IO::IncumbentStream> incumbentStream;
+        if (request.streamImprovements) {
+            const QJsonValue id = request.id;
+            incumbentStream = std::make_unique<IO::IncumbentStream>([id, &writeLine](const IO::IncumbentUpdate& update) {
+                writeLine(IO::ServerProtocol::ImprovementResponse(id, update));
+            }, request.streamIntervalInMilliseconds, false);
+        }
+
+        double timeLimitInMilliseconds = inputInformation.isTimeLimitSet_ ? inputInformation.timeLimitInSeconds_ * 1000 : Auxiliary::DINFTY;
+
+        std::unique_ptr<DataStructures::WindfarmResidual> windfarm = AcquireWindfarm(*cachedInstance);
+        IO::NCCLogger logger;
+        controler_.BuildAndRun(*cachedInstance->instance,
+                               *windfarm,
+                               logger,
+                               inputInformation,
+                               timeLimitInMilliseconds,
+                               false,
+                               std::cerr,
+                               nullptr,
+                               incumbentStream.get());
+
+        std::vector<int> flowOnOriginalEdges;
+        if (request.includeFlow) {
+            for (edgeID edge = 0; edge < windfarm->NumberOfOriginalEdges(); ++edge) {
+                flowOnOriginalEdges.push_back(windfarm->FlowOnEdge(edge));
+            }
+        }
+        writeLine(IO::ServerProtocol::ResultResponse(request.id,
+                                                     static_cast<int>(logger.SummaryRow().Status),
+                                                     windfarm->ComputeTotalCostOfFlow(),
+                                                     timer.ElapsedMilliseconds(),
+                                                     wasInstanceCached,
+                                                     request.includeFlow ? &flowOnOriginalEdges : nullptr));
+        ReleaseWindfarm(*cachedInstance, std::move(windfarm));
+    } catch (const std::string& message) {
+        writeLine(IO::ServerProtocol::ErrorResponse(request.id, message));
+    } catch (const std::exception& exception) {
+        writeLine(IO::ServerProtocol::ErrorResponse(request.id, exception.what()));
+    }
+}
+
+std::shared_ptr<CachedInstance> SolverServer::LoadInstance(const IO::ServerProtocol::Request& request, bool& wasCached) {
+    std::string content = request.inlineGraph;
+    if (!request.instancePath.empty()) {
+        std::ifstream file(request.instancePath);
+        if (!file.is_open()) {
+            throw "Could not open instance '" + request.instancePath + "'.";
+        }
+        std::ostringstream fileContent;
+        fileContent << file.rdbuf();
+        content = fileContent.str();
+    }
+
+    const std::size_t hash = std::hash<std::string>()(content);
+    {
+        std::lock_guard<std::mutex> lock(cacheMutex_);
+        for (const std::shared_ptr<CachedInstance>& cachedInstance : cache_[hash]) {
+            if (cachedInstance->content == content) {
+                wasCached = true;
+                return cachedInstance;
+            }
+        }
+    }
+
+    // Parse without holding the lock, so that requests on cached instances are not blocked.
+    DataStructures::InputInformation numbers(defaults_);
+    numbers.testsetNumber_ = Auxiliary::INFTY;
+    numbers.instanceNumber_ = Auxiliary::INFTY;
+    if (!request.instancePath.empty()) {
+        IO::SetInputFile(QString::fromStdString(request.instancePath), numbers);
+    }
+    std::shared_ptr<CachedInstance> newInstance = std::make_shared<CachedInstance>();
+    newInstance->instance = std::make_unique<DataStructures::Instance>(numbers.testsetNumber_, numbers.instanceNumber_);
+    std::istringstream input(content);
+    IO::ReadInstanceFromGMLStream(input, *newInstance->instance, defaults_.useOGDFReader_);
+    newInstance->content = std::move(content);
+
+    std::lock_guard<std::mutex> lock(cacheMutex_);
+    std::vector<std::shared_ptr<CachedInstance>>& bucket = cache_[hash];
+    for (const std::shared_ptr<CachedInstance>& cachedInstance : bucket) {
+        // Another request has parsed the same instance in the meantime.
+        if (cachedInstance->content == newInstance->content) {
+            wasCached = true;
+            return cachedInstance;
+        }
+    }
+    EvictUnusedInstancesIfFull();
+    cache_[hash].push_back(newInstance);
+    ++numberOfCachedInstances_;
+    wasCached = false;
+    return newInstance;
+}
+
+void SolverServer::EvictUnusedInstancesIfFull() {
+    if (numberOfCachedInstances_ < MAXIMUM_NUMBER_OF_CACHED_INSTANCES) { return; }
+
+    for (auto bucket = cache_.begin(); bucket != cache_.end(); ) {
+        std::vector<std::shared_ptr<CachedInstance>>& instances = bucket->second;
+        for (std::size_t i = 0; i < instances.size(); ) {
+            // The cache holds the only reference if no request uses the instance.
+            if (instances[i].use_count() == 1) {
+                instances[i] = std::move(instances.back());
+                instances.pop_back();
+                --numberOfCachedInstances_;
+            } else {
+                ++i;
+            }
+        }
+        bucket = instances.empty() ? cache_.erase(bucket) : std::next(bucket);
+    }
+}
+
+std::unique_ptr<DataStructures::WindfarmResidual> SolverServer::AcquireWindfarm(CachedInstance& cachedInstance) {
+    std::lock_guard<std::mutex> lock(cachedInstance.mutex);
+    if (!cachedInstance.idleWindfarms.empty()) {
+        std::unique_ptr<DataStructures::WindfarmResidual> windfarm = std::move(cachedInstance.idleWindfarms.back());
+        cachedInstance.idleWindfarms.pop_back();
+        return windfarm;
+    }
+    if (cachedInstance.windfarmWithoutFlow == nullptr) {
+        cachedInstance.windfarmWithoutFlow = std::make_unique<const DataStructures::WindfarmResidual>(*cachedInstance.instance);
+    }
+    // Copying only copies flow and residual costs, the topology is shared
+    return std::make_unique<DataStructures::WindfarmResidual>(*cachedInstance.windfarmWithoutFlow);
+}
+
+void SolverServer::ReleaseWindfarm(CachedInstance& cachedInstance, std::unique_ptr<DataStructures::WindfarmResidual> windfarm) {
+    windfarm->ClearFlow();
+    std::lock_guard<std::mutex> lock(cachedInstance.mutex);
+    cachedInstance.idleWindfarms.push_back(std::move(windfarm));
+}
+
+} // namespace Builders
+
+} // namespace wcp
@@ -5,31 +5,22 @@ namespace wcp {
 namespace DataStructures {
 
 Windfarm::Windfarm(const Instance& instance)
-  : numberOfOriginalVertices_(instance.Graph().numberOfNodes()),
-    numberOfOriginalEdges_(instance.Graph().numberOfEdges()),
-    numberOfTurbines_(0),
-    numberOfSubstations_(0),
-    listOfVertices_(numberOfOriginalVertices_ + 1, Vertex()),
-    cabletypes_(instance.CableTypes())
+  : topology_(std::make_shared<WindfarmTopology>(instance.NumberOfNodes(), instance.NumberOfEdges(), instance.CableTypes()))
 {
-    // Make sure that gml-file has been properly labeled
-    assert(instance.Graph().maxNodeIndex() + 1 == instance.Graph().numberOfNodes());
-    assert(instance.Graph().maxEdgeIndex() + 1 == instance.Graph().numberOfEdges());
-
-    for (auto v : instance.Graph().nodes) {
-        vertexID vIndex = v->index();
-        Vertex& vertex = VertexAt(vIndex);
+    for (vertexID vIndex = 0; vIndex < NumberOfOriginalVertices(); ++vIndex) {
+        const InstanceVertex& instanceVertex = instance.Vertices()[vIndex];
+        Vertex& vertex = MutableVertexAt(vIndex);
 
         vertex.Identifier() = vIndex;
-        vertex.X() = instance.GraphAttributes().x(v);
-        vertex.Y() = instance.GraphAttributes().y(v);
+        vertex.X() = instanceVertex.x;
+        vertex.Y() = instanceVertex.y;
         // Of what type is newVertex? Turbine or Substation?
-        if (instance.IsTurbine(v)) {
+        if (instanceVertex.type == VertexType::turbine) {
             vertex.Type() = VertexType::turbine;
             AddTurbine(vIndex);
-        } else if (instance.IsSubstation(v)) {
+        } else if (instanceVertex.type == VertexType::substation) {
             vertex.Type() = VertexType::substation;
-            vertex.Capacity() = instance.SubstationCapacity(v);
+            vertex.Capacity() = instanceVertex.capacity;
             AddSubstation(vIndex);
         }
     }
@@ -38,7 +29,7 @@ Windfarm::Windfarm(const Instance& instance)
     assert(NumberOfSubstations() + NumberOfTurbines() == NumberOfOriginalVertices());
 
     // Add super substation to the set of vertices
-    Vertex& superSubstation = VertexAt(NumberOfOriginalVertices());
+    Vertex& superSubstation = MutableVertexAt(NumberOfOriginalVertices());
     superSubstation.Identifier() = NumberOfOriginalVertices();
     superSubstation.Type() = VertexType::supersubstation;
 }
@@ -5,6 +5,9 @@
  *      Author: sascha
  */
 
+#include <algorithm>
+#include <utility>
+
 #include "DataStructures/Graphs/WindfarmResidual.h"
 
 namespace wcp {
@@ -12,30 +15,62 @@ namespace wcp {
 namespace DataStructures {
 
 WindfarmResidual::WindfarmResidual(const Instance& instance)
-  : Windfarm(instance)
+  : Windfarm(instance),
+    numberOfEdgesOutsideFlowHistogram_(0),
+    totalCostOfFlow_(0),
+    numberOfCostUpdatesSinceSummation_(0),
+    flowVersion_(0),
+    isFlowJournalOpen_(false),
+    hasFlowJournalOverflowed_(false),
+    hasEditedTopology_(false)
 {
+    // No flow exceeds the number of turbines
+    if (NumberOfTurbines() > std::numeric_limits<StoredFlow>::max()) {
+        throw "The wind farm has " + std::to_string(NumberOfTurbines()) + " turbines, but flows are stored for at most "
+                + std::to_string(std::numeric_limits<StoredFlow>::max()) + ". Build without WCP_COMPACT.";
+    }
+
     // Fill list of edges; vertices are constructed in the base class.
     InitializeEdges(2*NumberOfOriginalEdges() + 2*NumberOfSubstations());
+    if (instance.PrecomputedResidualGraph() != nullptr) {
+        CopyEdges(*instance.PrecomputedResidualGraph());
+    } else {
+        ComputeEdges(instance);
+    }
 
-    for (auto e : instance.Graph().edges) {
-        edgeID edgeIndex        = e->index();
-        vertexID sourceIndex    = e->source()->index();
-        vertexID targetIndex    = e->target()->index();
+    // Initialize Vector with Flow Values and Cost Values
+    flowValues_.resize(NumberOfOriginalEdges() + NumberOfSubstations(), 0);
+    residualCosts_.resize(NumberOfEdges(), 0);
 
-        Edge& edge          = EdgeAt(edgeIndex);
+    // All original edges start with zero flow
+    flowHistogram_.resize(2 * Cabletypes().MaximumCapacity() + 1, 0);
+    flowHistogram_[Cabletypes().MaximumCapacity()] = NumberOfOriginalEdges();
+    SumUpTotalCostOfFlow();
+
+    // Checking more changes than half the number of edges is not cheaper than looking at all edges
+    flowChangeLog_.resize(NumberOfOriginalEdges() / 2 + 1);
+}
+
+void WindfarmResidual::ComputeEdges(const Instance& instance) {
+    for (edgeID edgeIndex = 0; edgeIndex < NumberOfOriginalEdges(); ++edgeIndex) {
+        vertexID sourceIndex    = instance.Edges()[edgeIndex].source;
+        vertexID targetIndex    = instance.Edges()[edgeIndex].target;
+        const double length     = EuclideanDistance(sourceIndex, targetIndex);
+
+        Edge& edge          = MutableEdgeAt(edgeIndex);
         edge.Identifier()   = edgeIndex;
         edge.StartVertex()  = sourceIndex;
         edge.EndVertex()    = targetIndex;
-        edge.Length()       = Length(e, instance.GraphAttributes());
+        edge.Length()       = length;
         edge.Capacity()     = Cabletypes().MaximumCapacity();
         AddOutgoingEdge(sourceIndex, edgeIndex);
 
         edgeID reverseEdgeIndex     = edgeIndex + NumberOfOriginalEdges();
-        Edge& reverseEdge           = EdgeAt(reverseEdgeIndex);
+        Edge& reverseEdge           = MutableEdgeAt(reverseEdgeIndex);
         reverseEdge.Identifier()    = edgeIndex;
         reverseEdge.StartVertex()   = targetIndex;
         reverseEdge.EndVertex()     = sourceIndex;
-        reverseEdge.Length()        = Length(e, instance.GraphAttributes());
+        reverseEdge.Length()        = length;
         reverseEdge.Capacity()      = Cabletypes().MaximumCapacity();
         AddOutgoingEdge(targetIndex, reverseEdgeIndex);
     }
@@ -45,7 +80,7 @@ WindfarmResidual::WindfarmResidual(const Instance& instance)
 
         // Edges towards supersubstation
         edgeID towardsEdgeIndex     = 2 * NumberOfOriginalEdges() + i;
-        Edge& towardsEdge           = EdgeAt(towardsEdgeIndex);
+        Edge& towardsEdge           = MutableEdgeAt(towardsEdgeIndex);
         towardsEdge.Identifier()    = towardsEdgeIndex;
         towardsEdge.StartVertex()   = substation;
         towardsEdge.EndVertex()     = SuperSubstationIdentifier();
@@ -54,17 +89,64 @@ WindfarmResidual::WindfarmResidual(const Instance& instance)
 
         // Edges from supersubstation
         edgeID fromEdgeIndex = towardsEdgeIndex + NumberOfSubstations();
-        Edge& fromEdge = EdgeAt(fromEdgeIndex);
+        Edge& fromEdge = MutableEdgeAt(fromEdgeIndex);
         fromEdge.Identifier()   = fromEdgeIndex;
         fromEdge.StartVertex()  = SuperSubstationIdentifier();
         fromEdge.EndVertex()    = substation;
         fromEdge.Capacity()     = VertexCapacity(substation);
         AddOutgoingEdge(SuperSubstationIdentifier(), fromEdgeIndex);
     }
+}
 
-    // Initialize Vector with Flow Values and Cost Values
-    flowValues_.resize(NumberOfOriginalEdges() + NumberOfSubstations(), 0);
-    residualCosts_.resize(NumberOfEdges(), 0);
+void WindfarmResidual::CopyEdges(const IO::BinaryInstance::MappedFile& residualGraph) {
+    if (residualGraph.GetHeader().numberOfResidualEdges != NumberOfEdges()
+            || residualGraph.GetHeader().numberOfOriginalEdges != NumberOfOriginalEdges()) {
+        throw std::string("The residual graph of the binary instance does not fit its vertices.");
+    }
+
+    const std::int32_t* startVertex = residualGraph.EdgeStart();
+    const std::int32_t* endVertex   = residualGraph.EdgeEnd();
+    const std::int32_t* capacity    = residualGraph.EdgeCapacity();
+    const double*       length      = residualGraph.EdgeLength();
+    const std::int64_t* offsets     = residualGraph.AdjacencyOffsets();
+    const std::int32_t* adjacency   = residualGraph.Adjacency();
+
+    // The mapped arrays are not checked when the file is opened. Validate them before
+    // anything is copied, so that a corrupt file cannot lead to out-of-range indices.
+    for (edgeID edgeIndex = 0; edgeIndex < NumberOfEdges(); ++edgeIndex) {
+        if (startVertex[edgeIndex] < 0 || startVertex[edgeIndex] >= NumberOfVertices()
+                || endVertex[edgeIndex] < 0 || endVertex[edgeIndex] >= NumberOfVertices()
+                || !(length[edgeIndex] >= 0)) {
+            throw "The residual edge " + std::to_string(edgeIndex) + " of the binary instance is corrupt.";
+        }
+    }
+    if (offsets[0] != 0 || offsets[NumberOfVertices()] != NumberOfEdges()) {
+        throw std::string("The adjacency lists of the binary instance are corrupt.");
+    }
+    for (vertexID vertex = 0; vertex < NumberOfVertices(); ++vertex) {
+        if (offsets[vertex] > offsets[vertex + 1] || offsets[vertex + 1] > NumberOfEdges()) {
+            throw std::string("The adjacency lists of the binary instance are corrupt.");
+        }
+        for (std::int64_t position = offsets[vertex]; position < offsets[vertex + 1]; ++position) {
+            if (adjacency[position] < 0 || adjacency[position] >= NumberOfEdges() || startVertex[adjacency[position]] != vertex) {
+                throw "The adjacency list of vertex " + std::to_string(vertex) + " in the binary instance is corrupt.";
+            }
+        }
+    }
+
+    for (edgeID edgeIndex = 0; edgeIndex < NumberOfEdges(); ++edgeIndex) {
+        Edge& edge          = MutableEdgeAt(edgeIndex);
+        // Reverse edges carry the index of their original edge, see ComputeEdges
+        edge.Identifier()   = edgeIndex < 2 * NumberOfOriginalEdges() ? edgeIndex % NumberOfOriginalEdges() : edgeIndex;
+        edge.StartVertex()  = startVertex[edgeIndex];
+        edge.EndVertex()    = endVertex[edgeIndex];
+        edge.Length()       = length[edgeIndex];
+        edge.Capacity()     = capacity[edgeIndex];
+    }
+
+    for (vertexID vertex = 0; vertex < NumberOfVertices(); ++vertex) {
+        MutableVertexAt(vertex).OutgoingEdges().assign(adjacency + offsets[vertex], adjacency + offsets[vertex + 1]);
+    }
 }
 
 edgeID WindfarmResidual::ReverseEdgeIndex(edgeID index) const {
@@ -106,29 +188,224 @@ void WindfarmResidual::SetFlowOnEdge(edgeID index, int newFlow) {
     assert(index >= 0);
     assert(index < NumberOfEdges());
     if (index < NumberOfOriginalEdges()) {
-        flowValues_[index] = newFlow;
+        SetFlowInSlot(index, newFlow);
     } else if (index < 2*NumberOfOriginalEdges()) {
-        flowValues_[index - NumberOfOriginalEdges()] = -newFlow;
+        SetFlowInSlot(index - NumberOfOriginalEdges(), -newFlow);
     } else if (index < 2*NumberOfOriginalEdges() + NumberOfSubstations()) {
-        flowValues_[index - NumberOfOriginalEdges()] = newFlow;
+        SetFlowInSlot(index - NumberOfOriginalEdges(), newFlow);
     } else {
-        flowValues_[index - NumberOfOriginalEdges() - NumberOfSubstations()] = -newFlow;
+        SetFlowInSlot(index - NumberOfOriginalEdges() - NumberOfSubstations(), -newFlow);
+    }
+}
+
+void WindfarmResidual::ClearFlow() {
+    for (int slot = 0; slot < static_cast<int>(flowValues_.size()); ++slot) {
+        SetFlowInSlot(slot, 0);
     }
+    // Marks set before clearing must not be used by the next algorithm on this wind farm
+    CommitFlow();
+}
+
+void WindfarmResidual::RollbackFlow(std::size_t mark) {
+    assert(CanRollbackFlowTo(mark));
+    // The undoing changes must not be recorded themselves
+    isFlowJournalOpen_ = false;
+    while (flowJournal_.size() > mark) {
+        FlowChange change = flowJournal_.back();
+        flowJournal_.pop_back();
+        SetFlowInSlot(change.slot, change.previousFlow);
+    }
+    isFlowJournalOpen_ = true;
 }
 
 double WindfarmResidual::ComputeTotalCostOfFlow() const {
+#ifdef NDEBUG
+    if (NumberOfEdgesOutsideFlowHistogram() == 0) { return totalCostOfFlow_; }
+#endif
     double cost = 0.0;
     for (edgeID i = 0; i < NumberOfOriginalEdges(); ++i) {
         cost += ComputeCostOfFlowOnEdge(i);
     }
+    assert(NumberOfEdgesOutsideFlowHistogram() > 0 || std::abs(cost - totalCostOfFlow_) < Auxiliary::DOUBLE_ROUNDING_PRECISION);
     return cost;
 }
 
-void WindfarmResidual::writeFlowToOGDF(ogdf::Graph& graph, ogdf::GraphAttributes& graphAttr) {
-    for (auto edge = graph.firstEdge(); edge; edge = edge->succ()) {
-        graphAttr.label(edge) = std::to_string(edge->index());
-        graphAttr.doubleWeight(edge) = FlowOnEdge(edge->index());
+void WindfarmResidual::SumUpTotalCostOfFlow() {
+    int maximumCapacity = Cabletypes().MaximumCapacity();
+    totalCostOfFlow_ = 0.0;
+    for (edgeID edge = 0; edge < NumberOfOriginalEdges(); ++edge) {
+        int flow = FlowOnEdge(edge);
+        if (flow >= -maximumCapacity && flow <= maximumCapacity) {
+            totalCostOfFlow_ += Cabletypes().CostOfFlow(flow) * Length(edge);
+        }
+    }
+    numberOfCostUpdatesSinceSummation_ = 0;
+}
+
+void WindfarmResidual::writeFlowToOGDF(Instance& instance) {
+    if (HasEditedTopology()) {
+        throw std::string("The topology of the wind farm has been edited, so its flow cannot be written to the instance it was constructed from.");
+    }
+    instance.BuildOGDFGraph();
+    for (auto edge = instance.Graph().firstEdge(); edge; edge = edge->succ()) {
+        instance.GraphAttributes().label(edge) = std::to_string(edge->index());
+        instance.GraphAttributes().doubleWeight(edge) = FlowOnEdge(instance.EdgeIndexOfOriginalEdge(edge->index()));
+    }
+}
+
+void WindfarmResidual::MoveVertex(vertexID vertex, double x, double y) {
+    assert(!IsSuperSubstation(vertex));
+    hasEditedTopology_ = true;
+    MutableVertexAt(vertex).X() = x;
+    MutableVertexAt(vertex).Y() = y;
+
+    for (edgeID edge : OutgoingEdges(vertex)) {
+        if (IsSuperSubstation(EndVertex(edge))) { continue; }
+        double length = EuclideanDistance(StartVertex(edge), EndVertex(edge));
+        MutableEdgeAt(edge).Length() = length;
+        MutableEdgeAt(ReverseEdgeIndex(edge)).Length() = length;
+    }
+    SumUpTotalCostOfFlow();
+}
+
+void WindfarmResidual::SetSubstationCapacity(vertexID substation, int capacity) {
+    assert(IsSubstation(substation));
+    assert(capacity >= 0);
+    hasEditedTopology_ = true;
+    MutableVertexAt(substation).Capacity() = capacity;
+
+    edgeID towardsEdge = EdgeToSupersubstation(substation);
+    MutableEdgeAt(towardsEdge).Capacity() = capacity;
+    MutableEdgeAt(ReverseEdgeIndex(towardsEdge)).Capacity() = capacity;
+}
+
+edgeID WindfarmResidual::AddEdge(vertexID source, vertexID target) {
+    assert(source != target);
+    assert(!IsSuperSubstation(source) && !IsSuperSubstation(target));
+    hasEditedTopology_ = true;
+
+    std::vector<edgeID> newIndexOfOriginalEdge(NumberOfOriginalEdges());
+    for (edgeID edge = 0; edge < NumberOfOriginalEdges(); ++edge) {
+        newIndexOfOriginalEdge[edge] = edge;
     }
+    const edgeID newEdgeIndex = NumberOfOriginalEdges();
+    RenumberOriginalEdges(newIndexOfOriginalEdge, NumberOfOriginalEdges() + 1);
+
+    const edgeID reverseEdgeIndex = ReverseEdgeIndex(newEdgeIndex);
+    const double length = EuclideanDistance(source, target);
+
+    // The edge towards the supersubstation has to stay last, see EdgeToSupersubstation().
+    auto InsertOutgoingEdge = [this](vertexID vertex, edgeID edgeIndex) {
+        std::vector<edgeID>& outgoingEdges = MutableVertexAt(vertex).OutgoingEdges();
+        outgoingEdges.insert(IsSubstation(vertex) ? outgoingEdges.end() - 1 : outgoingEdges.end(), edgeIndex);
+    };
+
+    Edge& edge          = MutableEdgeAt(newEdgeIndex);
+    edge.Identifier()   = newEdgeIndex;
+    edge.StartVertex()  = source;
+    edge.EndVertex()    = target;
+    edge.Length()       = length;
+    edge.Capacity()     = Cabletypes().MaximumCapacity();
+    InsertOutgoingEdge(source, newEdgeIndex);
+
+    Edge& reverseEdge           = MutableEdgeAt(reverseEdgeIndex);
+    reverseEdge.Identifier()    = newEdgeIndex;
+    reverseEdge.StartVertex()   = target;
+    reverseEdge.EndVertex()     = source;
+    reverseEdge.Length()        = length;
+    reverseEdge.Capacity()      = Cabletypes().MaximumCapacity();
+    InsertOutgoingEdge(target, reverseEdgeIndex);
+
+    return newEdgeIndex;
+}
+
+void WindfarmResidual::RemoveEdge(edgeID edge) {
+    assert(edge >= 0);
+    assert(edge < NumberOfOriginalEdges());
+    assert(FlowOnEdge(edge) == 0);
+    hasEditedTopology_ = true;
+
+    std::vector<edgeID> newIndexOfOriginalEdge(NumberOfOriginalEdges());
+    for (edgeID i = 0; i < NumberOfOriginalEdges(); ++i) {
+        newIndexOfOriginalEdge[i] = i;
+    }
+    const edgeID lastEdge = NumberOfOriginalEdges() - 1;
+    newIndexOfOriginalEdge[lastEdge] = edge;
+    newIndexOfOriginalEdge[edge] = INVALID_EDGE;
+    RenumberOriginalEdges(newIndexOfOriginalEdge, NumberOfOriginalEdges() - 1);
+}
+
+void WindfarmResidual::RenumberOriginalEdges(const std::vector<edgeID>& newIndexOfOriginalEdge, int newNumberOfOriginalEdges) {
+    const int oldNumberOfOriginalEdges = NumberOfOriginalEdges();
+    assert(static_cast<int>(newIndexOfOriginalEdge.size()) == oldNumberOfOriginalEdges);
+
+    auto NewIndex = [&](edgeID edge) -> edgeID {
+        if (edge < oldNumberOfOriginalEdges) {
+            return newIndexOfOriginalEdge[edge];
+        } else if (edge < 2 * oldNumberOfOriginalEdges) {
+            edgeID newOriginalEdge = newIndexOfOriginalEdge[edge - oldNumberOfOriginalEdges];
+            return newOriginalEdge == INVALID_EDGE ? INVALID_EDGE : newOriginalEdge + newNumberOfOriginalEdges;
+        } else {
+            return edge - 2 * oldNumberOfOriginalEdges + 2 * newNumberOfOriginalEdges;
+        }
+    };
+
+    std::vector<Edge> edges(2 * newNumberOfOriginalEdges + 2 * NumberOfSubstations(), Edge());
+    std::vector<StoredCost> residualCosts(edges.size(), 0);
+    for (edgeID edge = 0; edge < NumberOfEdges(); ++edge) {
+        edgeID newEdge = NewIndex(edge);
+        if (newEdge == INVALID_EDGE) { continue; }
+        edges[newEdge] = EdgeAt(edge);
+        residualCosts[newEdge] = residualCosts_[edge];
+    }
+    for (edgeID edge = 0; edge < newNumberOfOriginalEdges; ++edge) {
+        edges[edge].Identifier() = edge;
+        edges[edge + newNumberOfOriginalEdges].Identifier() = edge;
+    }
+    for (edgeID edge = 2 * newNumberOfOriginalEdges; edge < static_cast<edgeID>(edges.size()); ++edge) {
+        edges[edge].Identifier() = edge;
+    }
+
+    std::vector<StoredFlow> flowValues(newNumberOfOriginalEdges + NumberOfSubstations(), 0);
+    for (edgeID edge = 0; edge < oldNumberOfOriginalEdges; ++edge) {
+        if (newIndexOfOriginalEdge[edge] == INVALID_EDGE) {
+            assert(flowValues_[edge] == 0);
+            continue;
+        }
+        flowValues[newIndexOfOriginalEdge[edge]] = flowValues_[edge];
+    }
+    for (int i = 0; i < NumberOfSubstations(); ++i) {
+        flowValues[newNumberOfOriginalEdges + i] = flowValues_[oldNumberOfOriginalEdges + i];
+    }
+
+    for (vertexID vertex = 0; vertex < NumberOfVertices(); ++vertex) {
+        std::vector<edgeID>& outgoingEdges = MutableVertexAt(vertex).OutgoingEdges();
+        std::vector<edgeID> renumberedEdges;
+        renumberedEdges.reserve(outgoingEdges.size());
+        for (edgeID edge : outgoingEdges) {
+            edgeID newEdge = NewIndex(edge);
+            if (newEdge != INVALID_EDGE) { renumberedEdges.push_back(newEdge); }
+        }
+        // The edge towards the supersubstation stays last, see EdgeToSupersubstation().
+        outgoingEdges.swap(renumberedEdges);
+    }
+
+    ReplaceEdges(std::move(edges), newNumberOfOriginalEdges);
+    flowValues_.swap(flowValues);
+    residualCosts_.swap(residualCosts);
+
+    std::fill(flowHistogram_.begin(), flowHistogram_.end(), 0);
+    numberOfEdgesOutsideFlowHistogram_ = 0;
+    flowHistogram_[Cabletypes().MaximumCapacity()] = NumberOfOriginalEdges();
+    for (edgeID edge = 0; edge < NumberOfOriginalEdges(); ++edge) {
+        UpdateFlowHistogram(0, flowValues_[edge]);
+    }
+    SumUpTotalCostOfFlow();
+
+    // Skip the version numbers that the discarded changes could still be looked up by.
+    flowChangeLog_.assign(NumberOfOriginalEdges() / 2 + 1, FlowChange{0, 0, 0});
+    flowVersion_ += flowChangeLog_.size() + 1;
+    CommitFlow();
 }
 
 } // namespace DataStructures
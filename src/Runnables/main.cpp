@@ -4,6 +4,10 @@
 
 #include <QCoreApplication>
 
+#include "Algorithms/VertexOrder.h"
+
+#include "Auxiliary/CancellationToken.h"
+
 #include "Builders/AlgorithmControler.h"
 #include "Builders/NCCControler.h"
 
@@ -11,6 +15,7 @@
 #include "DataStructures/Instance.h"
 #include "DataStructures/OutputInformation.h"
 
+#include "IO/InstanceFile.h"
 #include "IO/ParserFunctions.h"
 
 std::unique_ptr<wcp::Builders::AlgorithmControler> DecideOnAlgorithm(const wcp::DataStructures::InputInformation& inputInformation) {
@@ -47,16 +52,36 @@ int main(int argc, char *argv[]) {
 
         std::unique_ptr<wcp::DataStructures::InputInformation> allCommandLineInput = wcp::IO::SetUpParserAndProcessCommandLineInput(*application);
 
+        // SIGINT and SIGTERM stop the algorithms early but still write the best solution
+        wcp::Auxiliary::CancellationToken::InstallSignalHandlers();
+
         wcp::DataStructures::OutputInformation outputInformation(allCommandLineInput->outputdir_.toStdString(),
                                                  allCommandLineInput->verbose_,
                                                  allCommandLineInput->printSummary_,
                                                  allCommandLineInput->printDetails_,
                                                  allCommandLineInput->printSolution_);
 
+        std::unique_ptr<wcp::Builders::AlgorithmControler> algorithmControler = DecideOnAlgorithm(*allCommandLineInput);
+
+        if (allCommandLineInput->isBatchSet_) {
+            algorithmControler->BuildAndRunBatchAndOutput(*allCommandLineInput, outputInformation);
+            return 0;
+        }
+
+        if (allCommandLineInput->isServerSet_) {
+            algorithmControler->Serve(*allCommandLineInput, outputInformation);
+            return 0;
+        }
+
         wcp::DataStructures::Instance instance(allCommandLineInput->testsetNumber_, allCommandLineInput->instanceNumber_);
-        instance.ReadFromGMLFile(allCommandLineInput->inputfile_.toStdString());
+        wcp::IO::ReadInstanceFromFile(allCommandLineInput->inputfile_.toStdString(), instance, allCommandLineInput->useOGDFReader_);
+
+        if (allCommandLineInput->isConvertSet_) {
+            wcp::IO::WriteBinaryInstance(allCommandLineInput->convertFile_.toStdString(), instance);
+            return 0;
+        }
+        wcp::Algorithms::RenumberInstance(instance, allCommandLineInput->vertexOrder_.toStdString());
 
-        std::unique_ptr<wcp::Builders::AlgorithmControler> algorithmControler = DecideOnAlgorithm(*allCommandLineInput);
         PrintGeneralInformationOnAlgorithmAndInstance(outputInformation, algorithmControler->AlgorithmName(), instance);
         algorithmControler->BuildAndRunAndOutput(instance, *allCommandLineInput, outputInformation);
 